@@ -0,0 +1,480 @@
+#include <drogon/drogon.h>
+#include <drogon/HttpClient.h>
+#include <trantor/net/EventLoopThread.h>
+#include "filters/JwtAuthFilter.h"
+#include "utils/DbStats.h"
+#include "utils/SqlScript.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <future>
+#include <iostream>
+#include <mutex>
+#include <random>
+#include <sstream>
+
+// End-to-end load benchmark for the /cultural_nodes API.
+//
+// Starts the application in-process against a throwaway SQLite file (or
+// a MariaDB/MySQL database given with --db mysql), seeds it with synthetic
+// nodes and history rows, then drives getAll, getOne, create, update and
+// delete over keep-alive HTTP connections at each concurrency level. Each
+// virtual user sends its next request as soon as the previous response
+// arrives. Results are printed as JSON:
+//
+//   ./bench/api_load_bench --nodes 10000 --concurrency 1,16,64 --out run.json
+
+namespace
+{
+struct Options
+{
+    std::string db = "sqlite3";
+    std::string sqliteFile = "api_load_bench.sqlite";
+    std::string host = "127.0.0.1";
+    int dbPort = 3306;
+    std::string dbName = "culture_hub_bench";
+    std::string dbUser = "root";
+    std::string dbPassword;
+    uint16_t port = 18080;
+    size_t appThreads = 4;
+    size_t clientThreads = 4;
+    size_t connections = 8;
+    size_t nodes = 1000;
+    size_t history = 5000;
+    size_t requests = 2000;
+    std::vector<size_t> concurrency{1, 8, 32};
+    std::string out;
+};
+
+// Tables are dropped and recreated from the application's own schema
+// files, so the benchmark always runs against the columns and keys the
+// models and controllers expect
+const char *kDropTables[] = {
+    "DROP TABLE IF EXISTS cultural_node_tombstones",
+    "DROP TABLE IF EXISTS professional_history",
+    "DROP TABLE IF EXISTS cultural_nodes",
+};
+
+const char *kSorts[] = {"venue", "collective", "festival", "label", "radio"};
+const char *kCities[] = {"Buenos Aires", "Rosario", "Cordoba", "Mendoza", "La Plata"};
+
+std::vector<size_t> parseList(const std::string &text)
+{
+    std::vector<size_t> values;
+    std::stringstream in(text);
+    std::string item;
+    while (std::getline(in, item, ','))
+        values.push_back(std::stoul(item));
+    return values;
+}
+
+bool parseArgs(int argc, char **argv, Options &opts)
+{
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+        auto value = [&]() -> std::string {
+            if (i + 1 >= argc)
+                throw std::invalid_argument("missing value for " + arg);
+            return argv[++i];
+        };
+        if (arg == "--db")
+            opts.db = value() == "mysql" ? "mysql" : "sqlite3";
+        else if (arg == "--sqlite-file")
+            opts.sqliteFile = value();
+        else if (arg == "--db-host")
+            opts.host = value();
+        else if (arg == "--db-port")
+            opts.dbPort = std::stoi(value());
+        else if (arg == "--db-name")
+            opts.dbName = value();
+        else if (arg == "--db-user")
+            opts.dbUser = value();
+        else if (arg == "--db-password")
+            opts.dbPassword = value();
+        else if (arg == "--port")
+            opts.port = static_cast<uint16_t>(std::stoi(value()));
+        else if (arg == "--threads")
+            opts.appThreads = std::stoul(value());
+        else if (arg == "--client-threads")
+            opts.clientThreads = std::stoul(value());
+        else if (arg == "--connections")
+            opts.connections = std::stoul(value());
+        else if (arg == "--nodes")
+            opts.nodes = std::stoul(value());
+        else if (arg == "--history")
+            opts.history = std::stoul(value());
+        else if (arg == "--requests")
+            opts.requests = std::stoul(value());
+        else if (arg == "--concurrency")
+            opts.concurrency = parseList(value());
+        else if (arg == "--out")
+            opts.out = value();
+        else
+        {
+            std::cerr << "usage: api_load_bench [--db sqlite|mysql] [--sqlite-file F]\n"
+                         "  [--db-host H] [--db-port P] [--db-name N] [--db-user U]\n"
+                         "  [--db-password P] [--port P] [--threads N]\n"
+                         "  [--client-threads N] [--connections N] [--nodes N]\n"
+                         "  [--history N] [--requests N] [--concurrency 1,8,32]\n"
+                         "  [--out file.json]\n";
+            return false;
+        }
+    }
+    return !opts.concurrency.empty() && opts.nodes > 0;
+}
+
+Json::Value appConfig(const Options &opts)
+{
+    Json::Value listener;
+    listener["address"] = "127.0.0.1";
+    listener["port"] = opts.port;
+
+    Json::Value db;
+    db["name"] = "default";
+    db["rdbms"] = opts.db;
+    db["number_of_connections"] = static_cast<Json::UInt64>(opts.connections);
+    if (opts.db == "sqlite3")
+    {
+        db["filename"] = opts.sqliteFile;
+    }
+    else
+    {
+        db["host"] = opts.host;
+        db["port"] = opts.dbPort;
+        db["dbname"] = opts.dbName;
+        db["user"] = opts.dbUser;
+        db["passwd"] = opts.dbPassword;
+    }
+
+    Json::Value config;
+    config["listeners"].append(listener);
+    config["db_clients"].append(db);
+    config["app"]["threads_num"] = static_cast<Json::UInt64>(opts.appThreads);
+    config["app"]["log"]["log_level"] = "WARN";
+    return config;
+}
+
+void seed(const Options &opts)
+{
+    auto db = drogon::app().getDbClient();
+    for (auto *sql : kDropTables)
+        db->execSqlSync(sql);
+    auto schema = std::string(CULTURE_HUB_SQL_DIR) +
+                  (opts.db == "sqlite3" ? "/schema.sqlite.sql" : "/schema.mysql.sql");
+    for (const auto &sql : SqlScript::load(schema))
+        db->execSqlSync(sql);
+
+    // Multi-row inserts with generated literals keep seeding fast on both
+    // engines; every value is synthetic, nothing comes from outside.
+    const size_t batch = 500;
+    for (size_t first = 0; first < opts.nodes; first += batch)
+    {
+        std::string sql =
+            "INSERT INTO cultural_nodes (name, sort, description, website, city, country) "
+            "VALUES ";
+        for (size_t i = first; i < std::min(opts.nodes, first + batch); ++i)
+        {
+            if (i != first)
+                sql += ',';
+            sql += "('Node " + std::to_string(i) + "','" + kSorts[i % 5] +
+                   "','Synthetic node used by api_load_bench','https://example.org/" +
+                   std::to_string(i) + "','" + kCities[i % 5] + "','Argentina')";
+        }
+        db->execSqlSync(sql);
+    }
+    for (size_t first = 0; first < opts.history; first += batch)
+    {
+        std::string sql =
+            "INSERT INTO professional_history (project, node_id, sort, event_date, "
+            "event_description, fee) VALUES ";
+        for (size_t i = first; i < std::min(opts.history, first + batch); ++i)
+        {
+            if (i != first)
+                sql += ',';
+            sql += "('Project " + std::to_string(i) + "'," +
+                   std::to_string(1 + i % opts.nodes) + ",'concert','2025-0" +
+                   std::to_string(1 + i % 9) + "-15','Synthetic event'," +
+                   std::to_string(100 + i % 800) + ".50)";
+        }
+        db->execSqlSync(sql);
+    }
+}
+
+struct Run
+{
+    std::string op;
+    size_t total{0};
+    std::atomic<size_t> next{0};
+    std::atomic<size_t> errors{0};
+    std::vector<int64_t> latencyUs;
+    std::atomic<size_t> activeUsers{0};
+    std::promise<void> done;
+
+    std::mutex createdMutex;
+    std::vector<int> created;
+};
+
+int64_t steadyUs()
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+class VirtualUser : public std::enable_shared_from_this<VirtualUser>
+{
+  public:
+    VirtualUser(drogon::HttpClientPtr client,
+                Run &run,
+                const Options &opts,
+                const std::string &token,
+                const std::vector<int> &deletable,
+                unsigned seed)
+        : client_(std::move(client)),
+          run_(run),
+          opts_(opts),
+          token_(token),
+          deletable_(deletable),
+          rng_(seed)
+    {
+    }
+
+    void sendNext()
+    {
+        auto index = run_.next.fetch_add(1);
+        if (index >= run_.total)
+        {
+            if (--run_.activeUsers == 0)
+                run_.done.set_value();
+            return;
+        }
+
+        auto req = makeRequest(index);
+        auto start = steadyUs();
+        auto self = shared_from_this();
+        client_->sendRequest(req,
+                             [self, index, start](drogon::ReqResult result,
+                                                  const drogon::HttpResponsePtr &resp) {
+                                 self->run_.latencyUs[index] = steadyUs() - start;
+                                 if (result != drogon::ReqResult::Ok ||
+                                     resp->statusCode() >= 300)
+                                 {
+                                     ++self->run_.errors;
+                                 }
+                                 else if (self->run_.op == "create" &&
+                                          resp->getJsonObject())
+                                 {
+                                     std::lock_guard<std::mutex> lock(self->run_.createdMutex);
+                                     self->run_.created.push_back(
+                                         (*resp->getJsonObject())["id"].asInt());
+                                 }
+                                 self->sendNext();
+                             });
+    }
+
+  private:
+    drogon::HttpRequestPtr makeRequest(size_t index)
+    {
+        const auto &op = run_.op;
+        auto randomNode = [this]() {
+            return std::to_string(1 + rng_() % opts_.nodes);
+        };
+
+        drogon::HttpRequestPtr req;
+        if (op == "getAll")
+        {
+            req = drogon::HttpRequest::newHttpRequest();
+            req->setPath("/cultural_nodes");
+            req->setParameter("page", std::to_string(1 + index % std::max<size_t>(1, opts_.nodes / 20)));
+            req->setParameter("limit", "20");
+        }
+        else if (op == "getOne")
+        {
+            req = drogon::HttpRequest::newHttpRequest();
+            req->setPath("/cultural_nodes/" + randomNode());
+        }
+        else if (op == "create" || op == "update")
+        {
+            // (name, city) is unique: never reuse a name across runs
+            static std::atomic<size_t> serial{0};
+            Json::Value body;
+            body["name"] = "Bench node " + std::to_string(serial++);
+            body["sort"] = kSorts[index % 5];
+            body["city"] = kCities[index % 5];
+            body["country"] = "Argentina";
+            req = drogon::HttpRequest::newHttpJsonRequest(body);
+            if (op == "create")
+            {
+                req->setMethod(drogon::Post);
+                req->setPath("/cultural_nodes");
+            }
+            else
+            {
+                req->setMethod(drogon::Put);
+                req->setPath("/cultural_nodes/" + randomNode());
+            }
+        }
+        else
+        {
+            req = drogon::HttpRequest::newHttpRequest();
+            req->setMethod(drogon::Delete);
+            req->setPath("/cultural_nodes/" + std::to_string(deletable_[index]));
+        }
+        if (op == "create" || op == "update" || op == "delete")
+            req->addHeader("Authorization", "Bearer " + token_);
+        return req;
+    }
+
+    drogon::HttpClientPtr client_;
+    Run &run_;
+    const Options &opts_;
+    const std::string &token_;
+    const std::vector<int> &deletable_;
+    std::minstd_rand rng_;
+};
+
+Json::Value summarize(const Run &run, size_t concurrency, int64_t elapsedUs)
+{
+    auto sorted = run.latencyUs;
+    std::sort(sorted.begin(), sorted.end());
+    auto percentile = [&sorted](double q) -> Json::Int64 {
+        if (sorted.empty())
+            return 0;
+        return sorted[static_cast<size_t>(q * static_cast<double>(sorted.size() - 1))];
+    };
+
+    Json::Value result;
+    result["op"] = run.op;
+    result["concurrency"] = static_cast<Json::UInt64>(concurrency);
+    result["requests"] = static_cast<Json::UInt64>(run.total);
+    result["errors"] = static_cast<Json::UInt64>(run.errors.load());
+    result["duration_s"] = static_cast<double>(elapsedUs) / 1e6;
+    result["throughput_rps"] =
+        elapsedUs > 0 ? static_cast<double>(run.total) * 1e6 / static_cast<double>(elapsedUs)
+                      : 0.0;
+    result["latency_us"]["p50"] = percentile(0.50);
+    result["latency_us"]["p90"] = percentile(0.90);
+    result["latency_us"]["p99"] = percentile(0.99);
+    result["latency_us"]["max"] = sorted.empty() ? 0 : static_cast<Json::Int64>(sorted.back());
+    return result;
+}
+}  // namespace
+
+int main(int argc, char **argv)
+{
+    Options opts;
+    try
+    {
+        if (!parseArgs(argc, argv, opts))
+            return 2;
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << e.what() << "\n";
+        return 2;
+    }
+
+    // Write routes are guarded by JwtAuthFilter
+    setenv("JWT_SECRET", "api-load-bench-secret", 0);
+
+    auto config = appConfig(opts);
+    drogon::app().loadConfigJson(config);
+    DbStats::configure(config["db_clients"]);
+
+    std::promise<void> started;
+    std::thread server([&started]() {
+        drogon::app().getLoop()->queueInLoop([&started]() { started.set_value(); });
+        drogon::app().run();
+    });
+    started.get_future().get();
+
+    int status = 0;
+    Json::Value report;
+    try
+    {
+        seed(opts);
+
+        std::vector<std::unique_ptr<trantor::EventLoopThread>> clientLoops;
+        for (size_t i = 0; i < std::max<size_t>(1, opts.clientThreads); ++i)
+        {
+            clientLoops.push_back(std::make_unique<trantor::EventLoopThread>("bench-client"));
+            clientLoops.back()->run();
+        }
+
+        auto token = JwtAuthFilter::issue("api_load_bench");
+        auto url = "http://127.0.0.1:" + std::to_string(opts.port);
+        std::vector<int> deletable;
+        unsigned seedValue = 1;
+
+        for (auto concurrency : opts.concurrency)
+        {
+            std::vector<drogon::HttpClientPtr> clients;
+            for (size_t u = 0; u < concurrency; ++u)
+                clients.push_back(drogon::HttpClient::newHttpClient(
+                    url, clientLoops[u % clientLoops.size()]->getLoop()));
+
+            for (const char *op : {"getAll", "getOne", "create", "update", "delete"})
+            {
+                Run run;
+                run.op = op;
+                // Delete exactly the nodes this level created
+                run.total = run.op == "delete" ? deletable.size() : opts.requests;
+                run.latencyUs.assign(run.total, 0);
+                run.activeUsers = concurrency;
+
+                auto startUs = steadyUs();
+                for (size_t u = 0; u < concurrency; ++u)
+                {
+                    auto user = std::make_shared<VirtualUser>(
+                        clients[u], run, opts, token, deletable, seedValue++);
+                    clientLoops[u % clientLoops.size()]->getLoop()->queueInLoop(
+                        [user]() { user->sendNext(); });
+                }
+                run.done.get_future().get();
+                auto elapsedUs = steadyUs() - startUs;
+
+                if (run.op == "create")
+                    deletable = run.created;
+                else if (run.op == "delete")
+                    deletable.clear();
+
+                report["results"].append(summarize(run, concurrency, elapsedUs));
+                std::cerr << op << " @" << concurrency << ": "
+                          << report["results"][report["results"].size() - 1]["throughput_rps"]
+                                 .asDouble()
+                          << " req/s\n";
+            }
+        }
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << "api_load_bench failed: " << e.what() << "\n";
+        status = 1;
+    }
+
+    report["meta"]["db"] = opts.db;
+    report["meta"]["nodes"] = static_cast<Json::UInt64>(opts.nodes);
+    report["meta"]["history"] = static_cast<Json::UInt64>(opts.history);
+    report["meta"]["app_threads"] = static_cast<Json::UInt64>(opts.appThreads);
+    report["meta"]["db_connections"] = static_cast<Json::UInt64>(opts.connections);
+    report["meta"]["requests_per_op"] = static_cast<Json::UInt64>(opts.requests);
+
+    Json::StreamWriterBuilder writer;
+    writer["indentation"] = "  ";
+    auto text = Json::writeString(writer, report);
+    if (opts.out.empty())
+    {
+        std::cout << text << std::endl;
+    }
+    else
+    {
+        std::ofstream(opts.out) << text << std::endl;
+    }
+
+    drogon::app().getLoop()->queueInLoop([]() { drogon::app().quit(); });
+    server.join();
+    return status;
+}
@@ -0,0 +1,282 @@
+#include <benchmark/benchmark.h>
+#include <drogon/orm/DbClient.h>
+#include <models/CulturalNodes.h>
+#include <models/ProfessionalHistory.h>
+#include "utils/SqlScript.h"
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+// Per-row cost of the generated model code: construction from a Row and
+// from JSON, validation, toJson, and the SQL the Mapper builds for inserts
+// and updates. Each benchmark also reports heap allocations per operation
+// (counted by the global operator new below), which is usually the first
+// thing to move when the models are optimized.
+
+using drogon_model::culture_hub::CulturalNodes;
+using drogon_model::culture_hub::ProfessionalHistory;
+
+namespace
+{
+thread_local size_t allocations = 0;
+thread_local size_t allocatedBytes = 0;
+}  // namespace
+
+void *operator new(std::size_t size)
+{
+    ++allocations;
+    allocatedBytes += size;
+    if (auto *p = std::malloc(size ? size : 1))
+        return p;
+    throw std::bad_alloc();
+}
+
+void *operator new[](std::size_t size)
+{
+    return ::operator new(size);
+}
+
+void operator delete(void *p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete[](void *p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void *p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
+void operator delete[](void *p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
+namespace
+{
+// updateColumns() is private (only Mapper is a friend). Explicit template
+// instantiation is exempt from access checks, which lets the benchmark take
+// the member pointer without touching the generated headers.
+template <typename Tag, typename Tag::type Member>
+struct PrivateAccess
+{
+    friend typename Tag::type get(Tag)
+    {
+        return Member;
+    }
+};
+
+struct NodesUpdateColumns
+{
+    using type = const std::vector<std::string> (CulturalNodes::*)() const;
+    friend type get(NodesUpdateColumns);
+};
+template struct PrivateAccess<NodesUpdateColumns, &CulturalNodes::updateColumns>;
+
+struct HistoryUpdateColumns
+{
+    using type = const std::vector<std::string> (ProfessionalHistory::*)() const;
+    friend type get(HistoryUpdateColumns);
+};
+template struct PrivateAccess<HistoryUpdateColumns, &ProfessionalHistory::updateColumns>;
+
+template <typename T>
+struct Fixture;
+
+template <>
+struct Fixture<CulturalNodes>
+{
+    using UpdateColumns = NodesUpdateColumns;
+
+    static Json::Value json()
+    {
+        Json::Value body;
+        body["name"] = "Centro Cultural Recoleta";
+        body["sort"] = "cultural hub";
+        body["description"] = "Exhibitions, concerts and workshops in a restored cloister.";
+        body["website"] = "https://example.org/recoleta";
+        body["social"] = "{\"instagram\":\"@recoleta\"}";
+        body["contact"] = "{\"email\":\"info@example.org\"}";
+        body["address"] = "Junin 1930";
+        body["city"] = "Buenos Aires";
+        body["country"] = "Argentina";
+        return body;
+    }
+
+    static const char *select()
+    {
+        return "SELECT * FROM cultural_nodes";
+    }
+};
+
+template <>
+struct Fixture<ProfessionalHistory>
+{
+    using UpdateColumns = HistoryUpdateColumns;
+
+    static Json::Value json()
+    {
+        Json::Value body;
+        body["project"] = "Ciclo de Jazz";
+        body["node_id"] = 1;
+        body["sort"] = "concert";
+        body["event_date"] = "2025-05-15";
+        body["event_description"] = "Quartet performance, two sets.";
+        body["fee"] = "150.50";
+        return body;
+    }
+
+    static const char *select()
+    {
+        return "SELECT * FROM professional_history";
+    }
+};
+
+// One in-memory SQLite database with a single row per table, so the
+// Row-based constructors see the same kind of Row the Mapper hands them.
+drogon::orm::DbClientPtr database()
+{
+    static auto client = []() {
+        auto db = drogon::orm::DbClient::newSqlite3Client("filename=:memory:", 1);
+        for (const auto &sql :
+             SqlScript::load(std::string(CULTURE_HUB_SQL_DIR) + "/schema.sqlite.sql"))
+            db->execSqlSync(sql);
+        db->execSqlSync(
+            "INSERT INTO cultural_nodes (id, name, sort, description, website, social, "
+            "contact, address, city, country) VALUES (1, 'Centro Cultural Recoleta', "
+            "'cultural hub', 'Exhibitions, concerts and workshops in a restored cloister.', "
+            "'https://example.org/recoleta', '{\"instagram\":\"@recoleta\"}', "
+            "'{\"email\":\"info@example.org\"}', 'Junin 1930', 'Buenos Aires', 'Argentina')");
+        db->execSqlSync(
+            "INSERT INTO professional_history (id, project, node_id, sort, event_date, "
+            "event_description, fee) VALUES (1, 'Ciclo de Jazz', 1, 'concert', "
+            "'2025-05-15', 'Quartet performance, two sets.', '150.50')");
+        return db;
+    }();
+    return client;
+}
+
+template <typename T>
+const drogon::orm::Result &rows()
+{
+    static const auto result = database()->execSqlSync(Fixture<T>::select());
+    return result;
+}
+
+// Reports allocations per iteration for everything after construction
+class AllocationCounter
+{
+  public:
+    explicit AllocationCounter(benchmark::State &state)
+        : state_(state), count_(allocations), bytes_(allocatedBytes)
+    {
+    }
+
+    ~AllocationCounter()
+    {
+        state_.counters["allocs"] = benchmark::Counter(static_cast<double>(allocations - count_),
+                                                       benchmark::Counter::kAvgIterations);
+        state_.counters["alloc_bytes"] =
+            benchmark::Counter(static_cast<double>(allocatedBytes - bytes_),
+                               benchmark::Counter::kAvgIterations);
+    }
+
+  private:
+    benchmark::State &state_;
+    size_t count_;
+    size_t bytes_;
+};
+}  // namespace
+
+template <typename T>
+static void BM_FromRow(benchmark::State &state)
+{
+    const auto &result = rows<T>();
+    AllocationCounter counter(state);
+    for (auto _ : state)
+    {
+        T model(result[0]);
+        benchmark::DoNotOptimize(model);
+    }
+}
+BENCHMARK_TEMPLATE(BM_FromRow, CulturalNodes);
+BENCHMARK_TEMPLATE(BM_FromRow, ProfessionalHistory);
+
+template <typename T>
+static void BM_FromJson(benchmark::State &state)
+{
+    auto json = Fixture<T>::json();
+    AllocationCounter counter(state);
+    for (auto _ : state)
+    {
+        T model(json);
+        benchmark::DoNotOptimize(model);
+    }
+}
+BENCHMARK_TEMPLATE(BM_FromJson, CulturalNodes);
+BENCHMARK_TEMPLATE(BM_FromJson, ProfessionalHistory);
+
+template <typename T>
+static void BM_ValidateForCreation(benchmark::State &state)
+{
+    auto json = Fixture<T>::json();
+    std::string err;
+    AllocationCounter counter(state);
+    for (auto _ : state)
+    {
+        auto ok = T::validateJsonForCreation(json, err);
+        benchmark::DoNotOptimize(ok);
+    }
+}
+BENCHMARK_TEMPLATE(BM_ValidateForCreation, CulturalNodes);
+BENCHMARK_TEMPLATE(BM_ValidateForCreation, ProfessionalHistory);
+
+template <typename T>
+static void BM_ToJson(benchmark::State &state)
+{
+    T model(rows<T>()[0]);
+    AllocationCounter counter(state);
+    for (auto _ : state)
+    {
+        auto json = model.toJson();
+        benchmark::DoNotOptimize(json);
+    }
+}
+BENCHMARK_TEMPLATE(BM_ToJson, CulturalNodes);
+BENCHMARK_TEMPLATE(BM_ToJson, ProfessionalHistory);
+
+template <typename T>
+static void BM_UpdateColumns(benchmark::State &state)
+{
+    T model(Fixture<T>::json());
+    auto updateColumns = get(typename Fixture<T>::UpdateColumns{});
+    AllocationCounter counter(state);
+    for (auto _ : state)
+    {
+        auto columns = (model.*updateColumns)();
+        benchmark::DoNotOptimize(columns);
+    }
+}
+BENCHMARK_TEMPLATE(BM_UpdateColumns, CulturalNodes);
+BENCHMARK_TEMPLATE(BM_UpdateColumns, ProfessionalHistory);
+
+template <typename T>
+static void BM_SqlForInserting(benchmark::State &state)
+{
+    T model(Fixture<T>::json());
+    bool needSelection = false;
+    AllocationCounter counter(state);
+    for (auto _ : state)
+    {
+        auto sql = model.sqlForInserting(needSelection);
+        benchmark::DoNotOptimize(sql);
+    }
+}
+BENCHMARK_TEMPLATE(BM_SqlForInserting, CulturalNodes);
+BENCHMARK_TEMPLATE(BM_SqlForInserting, ProfessionalHistory);
+
+BENCHMARK_MAIN();
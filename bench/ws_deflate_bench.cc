@@ -0,0 +1,165 @@
+#include <benchmark/benchmark.h>
+#include <utils/WsDeflate.h>
+#include <optional>
+#include <string>
+#include <vector>
+
+// Per-message CPU cost and compression ratio of the /echo deflate envelope
+// for JSON event payloads of increasing size.
+
+namespace
+{
+std::string makeEvent(int index)
+{
+    return "{\"type\":\"node.updated\",\"node\":{\"id\":" + std::to_string(index) +
+           ",\"name\":\"Historic Museum " + std::to_string(index % 97) +
+           "\",\"sort\":\"venue\",\"city\":\"Buenos Aires\",\"country\":"
+           "\"Argentina\",\"website\":\"https://example.org/venues/" +
+           std::to_string(index) + "\"},\"ts\":" +
+           std::to_string(1767225600 + index) + "}";
+}
+
+// A batch of @p events events serialized as a JSON array
+std::string makePayload(int events, int seed)
+{
+    std::string payload = "[";
+    for (int i = 0; i < events; ++i)
+    {
+        if (i)
+            payload += ',';
+        payload += makeEvent(seed + i);
+    }
+    payload += ']';
+    return payload;
+}
+
+std::vector<std::string> makeMessages(int events)
+{
+    std::vector<std::string> messages;
+    for (int i = 0; i < 64; ++i)
+        messages.push_back(makePayload(events, i * events));
+    return messages;
+}
+
+WsDeflateCodec::Options makeOptions(bool contextTakeover)
+{
+    WsDeflateCodec::Options options;
+    options.contextTakeover = contextTakeover;
+    options.minSize = 0;
+    return options;
+}
+
+// Frames of @p messages sent in a row by one codec, as a receiver with
+// context takeover must replay them: the messages repeat until the stream
+// holds kStreamFrames frames.
+constexpr size_t kStreamFrames = 4096;
+
+std::vector<std::string> makeStream(const std::vector<std::string> &messages,
+                                    const WsDeflateCodec::Options &options,
+                                    bool envelope)
+{
+    WsDeflateCodec sender(options);
+    std::vector<std::string> frames(kStreamFrames);
+    for (size_t i = 0; i < frames.size(); ++i)
+    {
+        const auto &msg = messages[i % messages.size()];
+        if (envelope)
+            sender.encode(msg, true, frames[i]);
+        else
+            sender.compress(msg, frames[i]);
+    }
+    return frames;
+}
+}  // namespace
+
+static void BM_Compress(benchmark::State &state)
+{
+    auto messages = makeMessages(static_cast<int>(state.range(0)));
+    WsDeflateCodec codec(makeOptions(state.range(1) != 0));
+
+    size_t in = 0, out = 0, i = 0;
+    std::string frame;
+    for (auto _ : state)
+    {
+        const auto &msg = messages[i++ % messages.size()];
+        frame.clear();
+        codec.compress(msg, frame);
+        benchmark::DoNotOptimize(frame.data());
+        in += msg.size();
+        out += frame.size();
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(in));
+    state.counters["msg_bytes"] =
+        static_cast<double>(in) / static_cast<double>(state.iterations());
+    state.counters["ratio"] = static_cast<double>(out) / static_cast<double>(in);
+}
+BENCHMARK(BM_Compress)
+    ->ArgNames({"events", "takeover"})
+    ->ArgsProduct({{1, 10, 100}, {0, 1}});
+
+static void BM_Decompress(benchmark::State &state)
+{
+    auto messages = makeMessages(static_cast<int>(state.range(0)));
+    auto options = makeOptions(state.range(1) != 0);
+    auto frames = makeStream(messages, options, false);
+
+    // The receiver restarts with the stream, once every kStreamFrames
+    // iterations; only decompress() is timed in between.
+    std::optional<WsDeflateCodec> receiver;
+    receiver.emplace(options);
+    size_t in = 0, i = 0;
+    std::string payload;
+    for (auto _ : state)
+    {
+        if (i == frames.size())
+        {
+            state.PauseTiming();
+            receiver.emplace(options);
+            i = 0;
+            state.ResumeTiming();
+        }
+        payload.clear();
+        receiver->decompress(frames[i], payload);
+        benchmark::DoNotOptimize(payload.data());
+        in += messages[i++ % messages.size()].size();
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(in));
+}
+BENCHMARK(BM_Decompress)
+    ->ArgNames({"events", "takeover"})
+    ->ArgsProduct({{1, 10, 100}, {0, 1}});
+
+// What the echo handler does per enveloped message: decode + encode
+static void BM_EchoRoundTrip(benchmark::State &state)
+{
+    auto messages = makeMessages(static_cast<int>(state.range(0)));
+    auto options = makeOptions(state.range(1) != 0);
+    options.minSize = 256;
+    auto frames = makeStream(messages, options, true);
+
+    std::optional<WsDeflateCodec> server;
+    server.emplace(options);
+    size_t i = 0;
+    std::string payload, reply;
+    for (auto _ : state)
+    {
+        if (i == frames.size())
+        {
+            state.PauseTiming();
+            server.emplace(options);
+            i = 0;
+            state.ResumeTiming();
+        }
+        bool isText;
+        payload.clear();
+        reply.clear();
+        server->decode(frames[i++], payload, isText);
+        server->encode(payload, isText, reply);
+        benchmark::DoNotOptimize(reply.data());
+    }
+}
+BENCHMARK(BM_EchoRoundTrip)
+    ->ArgNames({"events", "takeover"})
+    ->ArgsProduct({{1, 10, 100}, {0, 1}});
+
+BENCHMARK_MAIN();
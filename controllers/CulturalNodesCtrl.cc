@@ -1,78 +1,955 @@
 #include "CulturalNodesCtrl.h"
+#include "plugins/IdempotencyStore.h"
+#include "plugins/TraceExporter.h"
+#include "models/ProfessionalHistory.h"
+#include "utils/BatchLoader.h"
+#include "utils/BulkTarget.h"
+#include "utils/DbStats.h"
+#include "utils/Metrics.h"
+#include "utils/OptimisticLock.h"
+#include "utils/RuntimeConfig.h"
+#include "utils/SingleFlight.h"
+#include "utils/TtlCache.h"
+#include "utils/WriteCoalescer.h"
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <map>
+#include <optional>
+#include <unordered_set>
 
 using namespace drogon;
 using namespace drogon::orm;
 using namespace drogon_model::culture_hub;
 
-void CulturalNodesCtrl::getAll(const HttpRequestPtr &req,   // ← req nombrado
-                               std::function<void(const HttpResponsePtr &)> &&callback)
+namespace
+{
+// What one single-flight call produces. Every joined request builds its
+// own HttpResponse from it, since advices add per-request headers, but the
+// query and the JSON serialization happen once.
+struct SharedResponse
+{
+    HttpStatusCode status{k200OK};
+    std::shared_ptr<const std::string> body;  // JSON; null for no body
+};
+
+using Flights = SingleFlight<SharedResponse>;
+
+// getOne keyed by id, getAll by normalized page/limit/sort
+Flights nodeFlights;
+Flights listFlights;
+
+using NodeId = CulturalNodes::PrimaryKeyType;
+using NodeJson = std::shared_ptr<const std::string>;
+using NodeLoader = BatchLoader<NodeId, NodeJson>;
+
+// Serialized rows by id, filled by every id lookup and invalidated by writes
+TtlCache<NodeId, std::string> nodeCache(65536);
+
+std::string writeJson(const Json::Value &json)
+{
+    Json::StreamWriterBuilder writer;
+    writer["indentation"] = "";
+    return Json::writeString(writer, json);
+}
+
+// social and contact are stored as JSON text: objects and arrays from the
+// client are serialized, strings are taken as already serialized and null
+// stays SQL NULL
+void normalizeJsonColumns(Json::Value &row)
+{
+    for (const auto &column : {CulturalNodes::Cols::_social, CulturalNodes::Cols::_contact})
+    {
+        if (!row.isMember(column))
+            continue;
+        auto &value = row[column];
+        if (value.isObject() || value.isArray())
+            value = writeJson(value);
+    }
+}
+
+// One SELECT ... WHERE id IN (...). Found rows are serialized once and
+// cached; ids without a row are simply absent from the result.
+void fetchNodes(std::vector<NodeId> ids,
+                const char *operation,
+                const Tracing::Span &span,
+                NodeLoader::Done done)
 {
     auto client = app().getDbClient();
     auto mapper = std::make_shared<Mapper<CulturalNodes>>(client);
 
+    auto startUs = DbStats::nowUs();
+    auto query = DbStats::start("cultural_nodes", operation, span);
+    auto count = ids.size();
+    mapper->findBy(
+        Criteria(CulturalNodes::Cols::_id, CompareOperator::In, std::move(ids)),
+        [done, mapper, query, operation, count, startUs](std::vector<CulturalNodes> nodes)
+        {
+            query.done(true);
+            Metrics::batchSize().observe({operation}, static_cast<double>(count));
+            auto ttlUs = RuntimeConfig::current().nodeCacheTtlMs * 1000;
+            auto now = DbStats::nowUs();
+            std::unordered_map<NodeId, NodeJson> found;
+            found.reserve(nodes.size());
+            for (auto &node : nodes)
+            {
+                auto json = std::make_shared<const std::string>(writeJson(node.toJson()));
+                nodeCache.put(node.getPrimaryKey(), json, startUs, now, ttlUs);
+                found.emplace(node.getPrimaryKey(), std::move(json));
+            }
+            done(true, std::move(found));
+        },
+        [done, mapper, query](const DrogonDbException &e)
+        {
+            query.done(false);
+            LOG_ERROR << "DB error: " << e.base().what();
+            done(false, {});
+        });
+}
+
+// Point lookups issued on the same IO loop within batching.window_ms are
+// resolved by one query
+NodeLoader nodeLoader([](std::vector<NodeId> ids, NodeLoader::Done done) {
+    fetchNodes(std::move(ids), "find_by_ids", Tracing::Span(), std::move(done));
+});
+
+NodeLoader::Options loaderOptions()
+{
+    const auto &settings = RuntimeConfig::current();
+    return {settings.batchWindowMs / 1000, static_cast<size_t>(settings.batchMaxIds)};
+}
+
+// Bumped after every committed write. Reads stamp their flight with it and
+// never join an older flight, so a read that starts after a write returned
+// is not answered by a query that began before the write.
+std::atomic<uint64_t> writeGeneration{0};
+
+uint64_t readGeneration()
+{
+    return writeGeneration.load(std::memory_order_acquire);
+}
+
+void writeCommitted()
+{
+    writeGeneration.fetch_add(1, std::memory_order_acq_rel);
+}
+
+void invalidateNode(NodeId id)
+{
+    nodeCache.invalidate(id, DbStats::nowUs());
+    writeCommitted();
+}
+
+// Current row of @p id as serialized JSON: from the cache, else through
+// the batched loader
+void loadNode(NodeId id, NodeLoader::Callback callback)
+{
+    if (auto json = nodeCache.get(id, DbStats::nowUs()))
+    {
+        callback(&json, false);
+        return;
+    }
+    nodeLoader.load(id, std::move(callback), loaderOptions());
+}
+
+HttpResponsePtr badRequest(const std::string &message)
+{
+    Json::Value errBody;
+    errBody["error"] = message;
+    auto resp = HttpResponse::newHttpJsonResponse(errBody);
+    resp->setStatusCode(k400BadRequest);
+    return resp;
+}
+
+HttpResponsePtr internalError()
+{
+    Json::Value errBody;
+    errBody["error"] = "Internal server error";
+    auto resp = HttpResponse::newHttpJsonResponse(errBody);
+    resp->setStatusCode(k500InternalServerError);
+    return resp;
+}
+
+HttpResponsePtr notFound()
+{
+    auto resp = HttpResponse::newHttpResponse();
+    resp->setStatusCode(k404NotFound);
+    return resp;
+}
+
+HttpResponsePtr preconditionFailed(int32_t version)
+{
+    Json::Value errBody;
+    errBody["error"] = "Node was modified by another request";
+    errBody["version"] = version;
+    auto resp = HttpResponse::newHttpJsonResponse(errBody);
+    resp->setStatusCode(k412PreconditionFailed);
+    resp->addHeader("ETag", OptimisticLock::etag(version));
+    return resp;
+}
+
+HttpResponsePtr nodeResponse(const Json::Value &node)
+{
+    auto resp = HttpResponse::newHttpJsonResponse(node);
+    resp->addHeader("ETag", OptimisticLock::etag(node["version"].asInt()));
+    return resp;
+}
+
+Json::Value parseNode(const std::string &json)
+{
+    Json::Value node;
+    std::string errs;
+    std::unique_ptr<Json::CharReader> reader(Json::CharReaderBuilder().newCharReader());
+    reader->parse(json.data(), json.data() + json.size(), &node, &errs);
+    return node;
+}
+
+void bindJson(orm::internal::SqlBinder &binder, const Json::Value &value)
+{
+    if (value.isNull())
+        binder << nullptr;
+    else if (value.isBool())
+        binder << value.asBool();
+    else if (value.isIntegral())
+        binder << value.asInt64();
+    else if (value.isDouble())
+        binder << value.asDouble();
+    else
+        binder << value.asString();
+}
+
+// UPDATE of the columns in @p values, applied only while the row is still at
+// @p version. @p done gets the affected row count, or nothing on a DB error.
+void casUpdate(NodeId id,
+               const Json::Value &values,
+               int32_t version,
+               const Tracing::Span &span,
+               std::function<void(std::optional<size_t> count)> done)
+{
+    auto columns = values.getMemberNames();
+    auto sql = OptimisticLock::updateSql(CulturalNodes::tableName,
+                                         CulturalNodes::primaryKeyName,
+                                         columns,
+                                         true);
+    auto client = app().getDbClient();
+    auto query = DbStats::start("cultural_nodes", "update", span);
+    auto binder = *client << std::move(sql);
+    for (const auto &column : columns)
+        bindJson(binder, values[column]);
+    binder << id << version;
+    binder >> [done, query](const Result &result)
+           {
+               query.done(true);
+               done(static_cast<size_t>(result.affectedRows()));
+           }
+           >> [done, query](const DrogonDbException &e)
+           {
+               query.done(false);
+               LOG_ERROR << "DB error: " << e.base().what();
+               done(std::nullopt);
+           };
+}
+
+// Equal as JSON values, with numbers compared by value (1 == 1.0 == 1u)
+bool sameDocument(const Json::Value &a, const Json::Value &b)
+{
+    if (a.isNumeric() && b.isNumeric())
+    {
+        if (a.isInt64() && b.isInt64())
+            return a.asInt64() == b.asInt64();
+        return a.asDouble() == b.asDouble();
+    }
+    if (a.type() != b.type())
+        return false;
+    if (a.isArray())
+    {
+        if (a.size() != b.size())
+            return false;
+        for (Json::ArrayIndex i = 0; i < a.size(); ++i)
+        {
+            if (!sameDocument(a[i], b[i]))
+                return false;
+        }
+        return true;
+    }
+    if (a.isObject())
+    {
+        if (a.size() != b.size())
+            return false;
+        for (const auto &name : a.getMemberNames())
+        {
+            if (!b.isMember(name) || !sameDocument(a[name], b[name]))
+                return false;
+        }
+        return true;
+    }
+    return a == b;
+}
+
+// social and contact are JSON columns: the database hands them back in its
+// own formatting, and a client may send the document itself, so both sides
+// are compared as documents rather than text
+bool sameValue(const std::string &column, const Json::Value &a, const Json::Value &b)
+{
+    if (column != CulturalNodes::Cols::_social && column != CulturalNodes::Cols::_contact)
+        return sameDocument(a, b);
+    auto document = [](const Json::Value &value) {
+        if (!value.isString())
+            return value;
+        auto parsed = parseNode(value.asString());
+        return parsed.isNull() ? value : parsed;
+    };
+    return sameDocument(document(a), document(b));
+}
+
+// Lost a compare-and-swap without an If-Match from the client this often:
+// give up with 409 rather than retry forever under contention
+constexpr int kWriteAttempts = 3;
+
+/**
+ * Read node @p id, apply @p changes and write them back conditioned on the
+ * version that was read, so a write can never silently overwrite one it
+ * did not see. With @p onlyChanged, columns already holding the requested
+ * value are left out of the UPDATE (and nothing is sent if none differ).
+ * A lost race re-reads and retries; when the client named a version with
+ * If-Match, the re-read is what turns the race into 412.
+ */
+void writeNode(NodeId id,
+               Json::Value changes,
+               bool onlyChanged,
+               const char *operation,
+               OptimisticLock::IfMatch ifMatch,
+               Tracing::Span span,
+               std::function<void(const HttpResponsePtr &)> callback,
+               int attempt = 1)
+{
+    loadNode(id, [=](const NodeJson *stored, bool failed) {
+        if (failed)
+        {
+            callback(internalError());
+            return;
+        }
+        if (!stored)
+        {
+            callback(notFound());
+            return;
+        }
+
+        auto current = parseNode(**stored);
+        auto version = current[CulturalNodes::Cols::_version].asInt();
+        if (ifMatch.kind == OptimisticLock::IfMatch::Kind::Version && ifMatch.version != version)
+        {
+            callback(preconditionFailed(version));
+            return;
+        }
+
+        // Known columns only: the names end up in the SQL text
+        Json::Value values(Json::objectValue);
+        for (size_t i = 0; i < CulturalNodes::getColumnNumber(); ++i)
+        {
+            const auto &column = CulturalNodes::getColumnName(i);
+            if (column == CulturalNodes::primaryKeyName || column == CulturalNodes::Cols::_version ||
+                !changes.isMember(column))
+                continue;
+            if (!onlyChanged || !sameValue(column, changes[column], current[column]))
+                values[column] = changes[column];
+        }
+        if (values.empty())
+        {
+            Metrics::skippedWrites().inc({operation});
+            callback(nodeResponse(current));
+            return;
+        }
+
+        casUpdate(id, values, version, span, [=](std::optional<size_t> count) {
+            invalidateNode(id);
+            if (!count)
+            {
+                callback(internalError());
+                return;
+            }
+            if (*count > 0)
+            {
+                // Answer with the row as stored (column types, JSON text,
+                // new version), not with what the client sent
+                loadNode(id, [callback](const NodeJson *written, bool failed) {
+                    if (failed)
+                        callback(internalError());
+                    else if (!written)
+                        callback(notFound());  // deleted right after the update
+                    else
+                        callback(nodeResponse(parseNode(**written)));
+                });
+                return;
+            }
+            // Updated or deleted since it was read
+            if (attempt < kWriteAttempts)
+            {
+                writeNode(id, changes, onlyChanged, operation, ifMatch, span, callback, attempt + 1);
+                return;
+            }
+            Json::Value errBody;
+            errBody["error"] = "Node is being modified concurrently, retry";
+            auto resp = HttpResponse::newHttpJsonResponse(errBody);
+            resp->setStatusCode(k409Conflict);
+            callback(resp);
+        });
+    });
+}
+
+// PUTs to one id within write_coalescing.window_ms go out as one UPDATE of
+// the union of their fields, later PUTs winning per field
+WriteCoalescer<NodeId, Json::Value, HttpResponsePtr> putCoalescer(
+    [](Json::Value &pending, const Json::Value &later) {
+        for (const auto &column : later.getMemberNames())
+            pending[column] = later[column];
+    },
+    [](const NodeId &id, Json::Value changes, std::function<void(HttpResponsePtr)> finish) {
+        writeNode(id, std::move(changes), false, "put", OptimisticLock::IfMatch{}, Tracing::Span(),
+                  [finish](const HttpResponsePtr &resp) { finish(resp); });
+    });
+
+// Every coalesced caller gets its own response object, since advices add
+// per-request headers
+HttpResponsePtr copyResponse(const HttpResponsePtr &resp)
+{
+    auto copy = HttpResponse::newHttpResponse();
+    copy->setStatusCode(resp->getStatusCode());
+    copy->setContentTypeCode(resp->contentType());
+    copy->setBody(std::string(resp->getBody()));
+    const auto &etag = resp->getHeader("ETag");
+    if (!etag.empty())
+        copy->addHeader("ETag", etag);
+    return copy;
+}
+
+// Stay under SQLite's default limit on bound parameters per statement
+constexpr size_t kMaxUpsertParameters = 999;
+
+// INSERT of @p rows rows setting @p columns, plus version 1
+std::string insertSql(const std::string &table, const std::vector<std::string> &columns, size_t rows)
+{
+    std::string tuple = "(";
+    for (size_t i = 0; i < columns.size(); ++i)
+        tuple += "?,";
+    tuple += "1)";
+
+    std::string sql = "insert into " + table + " (";
+    for (const auto &column : columns)
+        sql += column + ",";
+    sql += "version) values ";
+    for (size_t i = 0; i < rows; ++i)
+    {
+        sql += tuple;
+        sql += i + 1 < rows ? "," : "";
+    }
+    return sql;
+}
+
+// Multi-row INSERT of @p columns that updates the row on a (name, city)
+// collision instead. Every written row gets a new version.
+std::string upsertSql(orm::ClientType type, const std::vector<std::string> &columns, size_t rows)
+{
+    auto sql = insertSql(CulturalNodes::tableName, columns, rows);
+    if (type == orm::ClientType::Mysql)
+    {
+        sql += " on duplicate key update ";
+        for (const auto &column : columns)
+            sql += column + " = values(" + column + "),";
+    }
+    else
+    {
+        sql += " on conflict(name, city) do update set ";
+        for (const auto &column : columns)
+            sql += column + " = excluded." + column + ",";
+    }
+    sql += "version = version + 1";
+    return sql;
+}
+
+SharedResponse jsonResponse(const Json::Value &json, HttpStatusCode status = k200OK)
+{
+    return {status, std::make_shared<const std::string>(writeJson(json))};
+}
+
+// Columns bulk requests may select rows by, compared for equality
+const std::vector<std::string> &bulkFilterColumns()
+{
+    static const std::vector<std::string> columns{CulturalNodes::Cols::_city,
+                                                  CulturalNodes::Cols::_country,
+                                                  CulturalNodes::Cols::_sort};
+    return columns;
+}
+
+// Ids per bulk transaction, which keeps each one short; a delete binds two
+// parameters per id for the tombstones
+constexpr size_t kBulkChunkIds = 400;
+
+void bindFilter(orm::internal::SqlBinder &binder, const Json::Value &filter)
+{
+    for (const auto &column : filter.getMemberNames())
+        bindJson(binder, filter[column]);
+}
+
+// One bulk PATCH or DELETE, carried from chunk to chunk
+struct BulkJob
+{
+    std::vector<NodeId> ids;
+    Json::Value filter{Json::objectValue};
+    Json::Value values;  // columns to set; null for a delete
+    Tracing::Span span;
+    std::function<void(const HttpResponsePtr &)> callback;
+    size_t affected{0};
+
+    const char *countName() const
+    {
+        return values.isNull() ? "deleted" : "updated";
+    }
+};
+
+// Chunks commit independently: a failure reports how many rows the
+// committed ones changed
+void bulkFailed(const std::shared_ptr<BulkJob> &job)
+{
+    Json::Value errBody;
+    errBody["error"] = "Database error; rows of earlier chunks were committed";
+    errBody[job->countName()] = static_cast<Json::UInt64>(job->affected);
+    auto resp = HttpResponse::newHttpJsonResponse(errBody);
+    resp->setStatusCode(k500InternalServerError);
+    job->callback(resp);
+}
+
+/**
+ * Apply @p job to ids [first, first + kBulkChunkIds) in one transaction:
+ * select the rows that still match (locked on MySQL), write them with one
+ * set-based statement, and once committed invalidate exactly those ids
+ * before moving on to the next chunk.
+ */
+void runBulkChunk(std::shared_ptr<BulkJob> job, size_t first)
+{
+    if (first >= job->ids.size())
+    {
+        Json::Value body;
+        body[job->countName()] = static_cast<Json::UInt64>(job->affected);
+        job->callback(HttpResponse::newHttpJsonResponse(body));
+        return;
+    }
+
+    auto last = std::min(first + kBulkChunkIds, job->ids.size());
+    auto client = app().getDbClient();
+    auto lockRows = client->type() == orm::ClientType::Mysql;
+    client->newTransactionAsync([job, first, last, lockRows](
+                                    const std::shared_ptr<Transaction> &trans) {
+        if (!trans)
+        {
+            bulkFailed(job);
+            return;
+        }
+
+        // Settled once: by the first failure, or by the commit
+        auto settled = std::make_shared<std::atomic<bool>>(false);
+        auto found = std::make_shared<std::vector<NodeId>>();
+        auto fail = [job, settled](const std::shared_ptr<Transaction> &trans,
+                                   const DrogonDbException &e) {
+            LOG_ERROR << "DB error: " << e.base().what();
+            trans->rollback();
+            if (!settled->exchange(true))
+                bulkFailed(job);
+        };
+        trans->setCommitCallback([job, settled, found, last](bool committed) {
+            if (settled->exchange(true))
+                return;
+            if (!committed)
+            {
+                bulkFailed(job);
+                return;
+            }
+            for (auto id : *found)
+                invalidateNode(id);
+            job->affected += found->size();
+            runBulkChunk(job, last);
+        });
+
+        auto sql = "select id from " + CulturalNodes::tableName + " where id in (" +
+                   BulkTarget::placeholders(last - first) + ")";
+        if (!job->filter.empty())
+            sql += " and " + BulkTarget::filterSql(job->filter);
+        if (lockRows)
+            sql += " for update";
+        auto select = DbStats::start("cultural_nodes", "find_bulk", job->span);
+        auto binder = *trans << std::move(sql);
+        for (auto i = first; i < last; ++i)
+            binder << job->ids[i];
+        bindFilter(binder, job->filter);
+        binder >> [trans, job, found, fail, select](const Result &rows)
+               {
+                   select.done(true);
+                   for (const auto &row : rows)
+                       found->push_back(row["id"].as<NodeId>());
+                   // Nothing left to write; the empty transaction commits
+                   if (found->empty())
+                       return;
+
+                   auto remove = job->values.isNull();
+                   auto ids = "(" + BulkTarget::placeholders(found->size()) + ")";
+                   std::string sql;
+                   if (remove)
+                   {
+                       sql = "delete from " + CulturalNodes::tableName + " where id in " + ids;
+                   }
+                   else
+                   {
+                       sql = "update " + CulturalNodes::tableName + " set ";
+                       for (const auto &column : job->values.getMemberNames())
+                           sql += column + " = ?,";
+                       sql += "version = version + 1 where id in " + ids;
+                   }
+                   {
+                       auto write = DbStats::start("cultural_nodes",
+                                                   remove ? "delete_many" : "update_many",
+                                                   job->span);
+                       auto statement = *trans << std::move(sql);
+                       if (!remove)
+                           for (const auto &column : job->values.getMemberNames())
+                               bindJson(statement, job->values[column]);
+                       for (auto id : *found)
+                           statement << id;
+                       statement >> [write](const Result &) { write.done(true); }
+                                 >> [trans, fail, write](const DrogonDbException &e)
+                                 {
+                                     write.done(false);
+                                     fail(trans, e);
+                                 };
+                   }
+                   if (!remove)
+                       return;
+
+                   // Their history is removed later, in chunks, by HistoryPurger
+                   std::string tuples;
+                   for (size_t i = 0; i < found->size(); ++i)
+                       tuples += i == 0 ? "(?,?)" : ",(?,?)";
+                   auto deletedAt = trantor::Date::now().secondsSinceEpoch();
+                   auto tombstones =
+                       DbStats::start("cultural_node_tombstones", "insert_many", job->span);
+                   auto insert =
+                       *trans << "insert into cultural_node_tombstones (node_id, deleted_at) values " +
+                                     tuples;
+                   for (auto id : *found)
+                       insert << id << deletedAt;
+                   insert >> [tombstones](const Result &) { tombstones.done(true); }
+                          >> [trans, fail, tombstones](const DrogonDbException &e)
+                          {
+                              tombstones.done(false);
+                              fail(trans, e);
+                          };
+               }
+               >> [trans, fail, select](const DrogonDbException &e)
+               {
+                   select.done(false);
+                   fail(trans, e);
+               };
+    });
+}
+
+// Resolve a filter to the ids it matches, at most bulk.max_rows of them,
+// then run @p job chunk by chunk
+void startBulk(std::shared_ptr<BulkJob> job)
+{
+    auto maxRows = static_cast<size_t>(RuntimeConfig::current().bulkMaxRows);
+    auto tooMany = "At most " + std::to_string(maxRows) + " rows per bulk request";
+    if (!job->ids.empty())
+    {
+        if (job->ids.size() > maxRows)
+            job->callback(badRequest(tooMany));
+        else
+            runBulkChunk(std::move(job), 0);
+        return;
+    }
+
+    auto client = app().getDbClient();
+    auto query = DbStats::start("cultural_nodes", "find_bulk_filter", job->span);
+    auto binder = *client << "select id from " + CulturalNodes::tableName + " where " +
+                                 BulkTarget::filterSql(job->filter) + " order by id limit " +
+                                 std::to_string(maxRows + 1);
+    bindFilter(binder, job->filter);
+    binder >> [job, query, maxRows, tooMany](const Result &rows)
+           {
+               query.done(true);
+               if (rows.size() > maxRows)
+               {
+                   job->callback(badRequest(tooMany + "; narrow the filter"));
+                   return;
+               }
+               for (const auto &row : rows)
+                   job->ids.push_back(row["id"].as<NodeId>());
+               runBulkChunk(job, 0);
+           }
+           >> [job, query](const DrogonDbException &e)
+           {
+               query.done(false);
+               LOG_ERROR << "DB error: " << e.base().what();
+               job->callback(internalError());
+           };
+}
+
+Flights::Callback respondWith(std::function<void(const HttpResponsePtr &)> &&callback)
+{
+    return [callback = std::move(callback)](const SharedResponse &shared) {
+        auto resp = HttpResponse::newHttpResponse();
+        resp->setStatusCode(shared.status);
+        if (shared.body)
+        {
+            resp->setContentTypeCode(CT_APPLICATION_JSON);
+            resp->setBody(*shared.body);
+        }
+        callback(resp);
+    };
+}
+}  // namespace
+
+void CulturalNodesCtrl::getAll(const HttpRequestPtr &req,   // ← req nombrado
+                               std::function<void(const HttpResponsePtr &)> &&callback)
+{
+    const auto &idsParam = req->getParameter("ids");
+    if (!idsParam.empty())
+    {
+        std::vector<int> ids;
+        std::string_view rest(idsParam);
+        while (!rest.empty())
+        {
+            auto comma = rest.find(',');
+            auto item = rest.substr(0, comma);
+            int id = 0;
+            auto [end, ec] = std::from_chars(item.data(), item.data() + item.size(), id);
+            if (ec != std::errc() || end != item.data() + item.size())
+            {
+                callback(badRequest("ids must be a comma-separated list of integers"));
+                return;
+            }
+            ids.push_back(id);
+            if (comma == std::string_view::npos)
+                break;
+            rest.remove_prefix(comma + 1);
+        }
+        getMany(req, std::move(callback), std::move(ids));
+        return;
+    }
+
+    const auto &settings = RuntimeConfig::current();
     int page  = 1;
-    int limit = 20;
+    int limit = settings.defaultPageSize;
     auto pageStr    = req->getParameter("page");
     auto limitStr   = req->getParameter("limit");
     auto sortFilter = req->getParameter("sort");
 
     if (!pageStr.empty())  page  = std::stoi(pageStr);
     if (!limitStr.empty()) limit = std::stoi(limitStr);
-    if (limit > 100) limit = 100;
+    if (limit > settings.maxPageSize) limit = settings.maxPageSize;
 
-    auto callbackLambda = [callback](std::vector<CulturalNodes> nodes)
+    auto key = std::to_string(page) + '|' + std::to_string(limit) + '|' + sortFilter;
+    auto span = TraceExporter::requestSpan(req);
+    auto leader = listFlights.run(
+        key, respondWith(std::move(callback)), [page, limit, sortFilter, span](Flights::Finish finish)
     {
-        Json::Value arr(Json::arrayValue);
-        for (auto &n : nodes)
-            arr.append(n.toJson());
-        callback(HttpResponse::newHttpJsonResponse(arr));
-    };
+        auto client = app().getDbClient();
+        auto mapper = std::make_shared<Mapper<CulturalNodes>>(client);
 
-    auto errorLambda = [callback](const DrogonDbException &e)
-    {
-        LOG_ERROR << "DB error: " << e.base().what();
-        Json::Value errBody;
-        errBody["error"] = "Internal server error";
-        auto resp = HttpResponse::newHttpJsonResponse(errBody);
-        resp->setStatusCode(k500InternalServerError);
-        callback(resp);
-    };
+        auto query = DbStats::start("cultural_nodes", "find", span);
+        auto callbackLambda = [finish, query, span](std::vector<CulturalNodes> nodes)
+        {
+            query.done(true);
+            auto serialize = span.child("serialize");
+            Json::Value arr(Json::arrayValue);
+            for (auto &n : nodes)
+                arr.append(n.toJson());
+            auto shared = jsonResponse(arr);
+            serialize.end("rows", static_cast<int64_t>(nodes.size()));
+            finish(std::move(shared));
+        };
+
+        auto errorLambda = [finish, query](const DrogonDbException &e)
+        {
+            query.done(false);
+            LOG_ERROR << "DB error: " << e.base().what();
+            Json::Value errBody;
+            errBody["error"] = "Internal server error";
+            finish(jsonResponse(errBody, k500InternalServerError));
+        };
 
-    mapper->orderBy(CulturalNodes::Cols::_name)
-           .paginate(page, limit);
+        mapper->orderBy(CulturalNodes::Cols::_name)
+               .paginate(page, limit);
 
-    if (!sortFilter.empty())
-        mapper->findBy(
-            Criteria(CulturalNodes::Cols::_sort, CompareOperator::EQ, sortFilter),
-            callbackLambda,
-            errorLambda);
-    else
-        mapper->findAll(callbackLambda, errorLambda);
+        if (!sortFilter.empty())
+            mapper->findBy(
+                Criteria(CulturalNodes::Cols::_sort, CompareOperator::EQ, sortFilter),
+                callbackLambda,
+                errorLambda);
+        else
+            mapper->findAll(callbackLambda, errorLambda);
+    }, readGeneration());
+    if (!leader)
+        Metrics::coalescedRequests().inc({"find"});
 }
 
-void CulturalNodesCtrl::getOne(const HttpRequestPtr &,
+void CulturalNodesCtrl::getOne(const HttpRequestPtr &req,
                                std::function<void(const HttpResponsePtr &)> &&callback,
                                int id)
 {
-    auto client = app().getDbClient();
-    auto mapper = std::make_shared<Mapper<CulturalNodes>>(client);
+    if (auto json = nodeCache.get(id, DbStats::nowUs()))
+    {
+        respondWith(std::move(callback))({k200OK, std::move(json)});
+        return;
+    }
 
-    mapper->findByPrimaryKey(
-        id,
-        [callback, mapper](CulturalNodes node)
+    auto span = TraceExporter::requestSpan(req);
+    auto leader = nodeFlights.run(
+        std::to_string(id), respondWith(std::move(callback)), [id, span](Flights::Finish finish)
+    {
+        auto wait = span.child("db.batch");
+        nodeLoader.load(
+            id,
+            [finish, wait](const NodeJson *json, bool failed)
+            {
+                wait.end(nullptr, 0, failed);
+                if (failed)
+                {
+                    Json::Value errBody;
+                    errBody["error"] = "Internal server error";
+                    finish(jsonResponse(errBody, k500InternalServerError));
+                    return;
+                }
+                if (!json)
+                {
+                    finish({k404NotFound, nullptr});
+                    return;
+                }
+                finish({k200OK, *json});
+            },
+            loaderOptions());
+    }, readGeneration());
+    if (!leader)
+        Metrics::coalescedRequests().inc({"find_by_id"});
+}
+
+void CulturalNodesCtrl::lookup(const HttpRequestPtr &req,
+                               std::function<void(const HttpResponsePtr &)> &&callback)
+{
+    auto json = req->getJsonObject();
+    if (!json || !(*json)["ids"].isArray())
+    {
+        callback(badRequest("Expected a JSON body {\"ids\": [...]}"));
+        return;
+    }
+
+    std::vector<int> ids;
+    ids.reserve((*json)["ids"].size());
+    for (const auto &id : (*json)["ids"])
+    {
+        if (!id.isInt())
         {
-            callback(HttpResponse::newHttpJsonResponse(node.toJson()));
-        },
-        [callback, mapper](const DrogonDbException &)
+            callback(badRequest("ids must be integers"));
+            return;
+        }
+        ids.push_back(id.asInt());
+    }
+    getMany(req, std::move(callback), std::move(ids));
+}
+
+void CulturalNodesCtrl::getMany(const HttpRequestPtr &req,
+                                std::function<void(const HttpResponsePtr &)> &&callback,
+                                std::vector<int> ids)
+{
+    auto maxIds = RuntimeConfig::current().multiGetMaxIds;
+    if (ids.empty() || ids.size() > static_cast<size_t>(maxIds))
+    {
+        callback(badRequest("ids must list between 1 and " + std::to_string(maxIds) + " ids"));
+        return;
+    }
+
+    // Cached rows are answered from memory; the rest come from one IN query
+    auto now = DbStats::nowUs();
+    auto bodies = std::make_shared<std::vector<NodeJson>>(ids.size());
+    std::vector<NodeId> missing;
+    std::unordered_set<NodeId> requested;
+    for (size_t i = 0; i < ids.size(); ++i)
+    {
+        (*bodies)[i] = nodeCache.get(ids[i], now);
+        if (!(*bodies)[i] && requested.insert(ids[i]).second)
+            missing.push_back(ids[i]);
+    }
+
+    // Request order, null where no row exists; rows are spliced in as
+    // already-serialized JSON
+    auto respond = [callback, bodies]()
+    {
+        std::string body;
+        size_t size = 2;
+        for (const auto &json : *bodies)
+            size += (json ? json->size() : 4) + 1;
+        body.reserve(size);
+        body += '[';
+        for (size_t i = 0; i < bodies->size(); ++i)
         {
-            auto resp = HttpResponse::newHttpResponse();
-            resp->setStatusCode(k404NotFound);
-            callback(resp);
-        });
+            if (i > 0)
+                body += ',';
+            body += (*bodies)[i] ? *(*bodies)[i] : "null";
+        }
+        body += ']';
+        auto resp = HttpResponse::newHttpResponse();
+        resp->setContentTypeCode(CT_APPLICATION_JSON);
+        resp->setBody(std::move(body));
+        callback(resp);
+    };
+
+    if (missing.empty())
+    {
+        respond();
+        return;
+    }
+
+    fetchNodes(std::move(missing),
+               "multi_get",
+               TraceExporter::requestSpan(req),
+               [callback, respond, bodies, ids = std::move(ids)](
+                   bool ok, std::unordered_map<NodeId, NodeJson> found)
+               {
+                   if (!ok)
+                   {
+                       Json::Value errBody;
+                       errBody["error"] = "Internal server error";
+                       auto resp = HttpResponse::newHttpJsonResponse(errBody);
+                       resp->setStatusCode(k500InternalServerError);
+                       callback(resp);
+                       return;
+                   }
+                   for (size_t i = 0; i < ids.size(); ++i)
+                   {
+                       if ((*bodies)[i])
+                           continue;
+                       auto it = found.find(ids[i]);
+                       if (it != found.end())
+                           (*bodies)[i] = it->second;
+                   }
+                   respond();
+               });
 }
 
 void CulturalNodesCtrl::create(const HttpRequestPtr &req,
                                std::function<void(const HttpResponsePtr &)> &&callback)
+{
+    // Retries carrying an Idempotency-Key get the first attempt's response
+    if (auto *store = app().getPlugin<IdempotencyStore>())
+    {
+        store->handle(req, std::move(callback), [this, req](IdempotencyStore::Callback respond) {
+            insertNode(req, std::move(respond));
+        });
+        return;
+    }
+    insertNode(req, std::move(callback));
+}
+
+void CulturalNodesCtrl::insertNode(const HttpRequestPtr &req,
+                                   std::function<void(const HttpResponsePtr &)> &&callback)
 {
     auto json = req->getJsonObject();
     if (!json)
@@ -85,14 +962,7 @@ void CulturalNodesCtrl::create(const HttpRequestPtr &req,
         return;
     }
 
-    for (const auto &field : {"social", "contact"})
-    {
-        if (json->isMember(field) && (*json)[field].isObject())
-        {
-            Json::StreamWriterBuilder writer;
-            (*json)[field] = Json::writeString(writer, (*json)[field]);
-        }
-    }
+    normalizeJsonColumns(*json);
 
     std::string err;
     if (!CulturalNodes::validateJsonForCreation(*json, err))
@@ -105,20 +975,27 @@ void CulturalNodesCtrl::create(const HttpRequestPtr &req,
         return;
     }
 
+    // New rows start at version 1
+    (*json)[CulturalNodes::Cols::_version] = 1;
     CulturalNodes node(*json);
     auto client = app().getDbClient();
     auto mapper = std::make_shared<Mapper<CulturalNodes>>(client);
 
+    auto span = TraceExporter::requestSpan(req);
+    auto query = DbStats::start("cultural_nodes", "insert", span);
     mapper->insert(
         node,
-        [callback, mapper](CulturalNodes inserted)
+        [callback, mapper, query](CulturalNodes inserted)
         {
+            query.done(true);
+            writeCommitted();
             auto resp = HttpResponse::newHttpJsonResponse(inserted.toJson());
             resp->setStatusCode(k201Created);
             callback(resp);
         },
-        [callback, mapper](const DrogonDbException &e)
+        [callback, mapper, query](const DrogonDbException &e)
         {
+            query.done(false);
             LOG_ERROR << "DB error: " << e.base().what();
             Json::Value errBody;
             errBody["error"] = "Internal server error";
@@ -143,17 +1020,19 @@ void CulturalNodesCtrl::update(const HttpRequestPtr &req,
         return;
     }
 
-    (*json)["id"] = id;
-
-    for (const auto &field : {"social", "contact"})
+    auto ifMatch = OptimisticLock::parseIfMatch(req->getHeader("If-Match"));
+    if (ifMatch.kind == OptimisticLock::IfMatch::Kind::Invalid)
     {
-        if (json->isMember(field) && (*json)[field].isObject())
-        {
-            Json::StreamWriterBuilder writer;
-            (*json)[field] = Json::writeString(writer, (*json)[field]);
-        }
+        callback(badRequest("If-Match must be * or a version ETag"));
+        return;
     }
 
+    (*json)["id"] = id;
+    // Owned by the server; clients name the version they saw with If-Match
+    json->removeMember(CulturalNodes::Cols::_version);
+
+    normalizeJsonColumns(*json);
+
     std::string err;
     if (!CulturalNodes::validateJsonForUpdate(*json, err))
     {
@@ -165,63 +1044,599 @@ void CulturalNodesCtrl::update(const HttpRequestPtr &req,
         return;
     }
 
-    CulturalNodes node(*json);
-    auto client = app().getDbClient();
-    auto mapper = std::make_shared<Mapper<CulturalNodes>>(client);
+    // A write conditioned on a version is checked against exactly that
+    // version, so it is never merged with others
+    auto windowMs = RuntimeConfig::current().writeCoalesceMs;
+    if (windowMs > 0 && ifMatch.kind != OptimisticLock::IfMatch::Kind::Version)
+    {
+        auto respond = [callback = std::move(callback)](const HttpResponsePtr &resp) {
+            callback(copyResponse(resp));
+        };
+        if (!putCoalescer.submit(id, *json, std::move(respond), windowMs / 1000))
+            Metrics::coalescedRequests().inc({"put_merged"});
+        return;
+    }
 
-    mapper->update(
-        node,
-        [callback, mapper, node](size_t count)
+    writeNode(id, *json, false, "put", ifMatch, TraceExporter::requestSpan(req), std::move(callback));
+}
+
+void CulturalNodesCtrl::remove(const HttpRequestPtr &req,
+                               std::function<void(const HttpResponsePtr &)> &&callback,
+                               int id)
+{
+    auto ifMatch = OptimisticLock::parseIfMatch(req->getHeader("If-Match"));
+    if (ifMatch.kind == OptimisticLock::IfMatch::Kind::Invalid)
+    {
+        callback(badRequest("If-Match must be * or a version ETag"));
+        return;
+    }
+    auto conditional = ifMatch.kind == OptimisticLock::IfMatch::Kind::Version;
+    Criteria criteria(CulturalNodes::Cols::_id, CompareOperator::EQ, id);
+    if (conditional)
+        criteria = criteria &&
+                   Criteria(CulturalNodes::Cols::_version, CompareOperator::EQ, ifMatch.version);
+
+    // The node row and a tombstone for it go in one transaction; its
+    // history is deleted afterwards in small chunks by HistoryPurger, so
+    // this never locks more than the one row
+    auto span = TraceExporter::requestSpan(req);
+    auto client = app().getDbClient();
+    client->newTransactionAsync([callback, criteria, span, id, conditional](
+                                    const std::shared_ptr<Transaction> &trans) {
+        if (!trans)
         {
-            if (count == 0)
+            callback(internalError());
+            return;
+        }
+        auto responded = std::make_shared<std::atomic<bool>>(false);
+        trans->setCommitCallback([callback, responded, id](bool committed) {
+            if (responded->exchange(true))
+                return;
+            if (!committed)
             {
-                auto resp = HttpResponse::newHttpResponse();
-                resp->setStatusCode(k404NotFound);
-                callback(resp);
+                callback(internalError());
                 return;
             }
-            callback(HttpResponse::newHttpJsonResponse(node.toJson())); // 200 con body
-        },
-        [callback, mapper](const DrogonDbException &e)
-        {
-            LOG_ERROR << "DB error: " << e.base().what();
-            Json::Value errBody;
-            errBody["error"] = "Internal server error";
-            auto resp = HttpResponse::newHttpJsonResponse(errBody);
-            resp->setStatusCode(k500InternalServerError);
+            // Only now: a read between the delete and the commit still sees
+            // the row and must not be able to cache it after this
+            invalidateNode(id);
+            auto resp = HttpResponse::newHttpResponse();
+            resp->setStatusCode(k204NoContent);
             callback(resp);
         });
+        auto fail = [callback, responded, trans](const DrogonDbException &e) {
+            LOG_ERROR << "DB error: " << e.base().what();
+            trans->rollback();
+            if (!responded->exchange(true))
+                callback(internalError());
+        };
+
+        auto mapper = std::make_shared<Mapper<CulturalNodes>>(trans);
+        auto query = DbStats::start("cultural_nodes", "delete", span);
+        mapper->deleteBy(
+            criteria,
+            [callback, trans, mapper, query, span, id, conditional, responded, fail](size_t count)
+            {
+                query.done(true);
+                if (count == 0)
+                {
+                    responded->store(true);
+                    trans->rollback();
+                    if (!conditional)
+                    {
+                        callback(notFound());
+                        return;
+                    }
+                    // Gone, or still there at another version
+                    loadNode(id, [callback](const NodeJson *stored, bool failed) {
+                        if (failed)
+                            callback(internalError());
+                        else if (!stored)
+                            callback(notFound());
+                        else
+                            callback(preconditionFailed(
+                                parseNode(**stored)[CulturalNodes::Cols::_version].asInt()));
+                    });
+                    return;
+                }
+                auto tombstone = DbStats::start("cultural_node_tombstones", "insert", span);
+                *trans << "insert into cultural_node_tombstones (node_id, deleted_at) values (?, ?)"
+                       << id << trantor::Date::now().secondsSinceEpoch()
+                       >> [tombstone](const Result &) { tombstone.done(true); }
+                       >> [tombstone, fail](const DrogonDbException &e)
+                       {
+                           tombstone.done(false);
+                           fail(e);
+                       };
+            },
+            [query, fail](const DrogonDbException &e)
+            {
+                query.done(false);
+                fail(e);
+            });
+    });
 }
 
-void CulturalNodesCtrl::remove(const HttpRequestPtr &,
-                               std::function<void(const HttpResponsePtr &)> &&callback,
-                               int id)
+void CulturalNodesCtrl::patch(const HttpRequestPtr &req,
+                              std::function<void(const HttpResponsePtr &)> &&callback,
+                              int id)
 {
+    auto json = req->getJsonObject();
+    if (!json || !json->isObject())
+    {
+        callback(badRequest("Invalid or missing JSON body"));
+        return;
+    }
+
+    auto ifMatch = OptimisticLock::parseIfMatch(req->getHeader("If-Match"));
+    if (ifMatch.kind == OptimisticLock::IfMatch::Kind::Invalid)
+    {
+        callback(badRequest("If-Match must be * or a version ETag"));
+        return;
+    }
+
+    auto changes = *json;
+    changes.removeMember(CulturalNodes::Cols::_version);
+    normalizeJsonColumns(changes);
+
+    // Only the fields present are validated
+    changes["id"] = id;
+    std::string err;
+    if (!CulturalNodes::validateJsonForUpdate(changes, err))
+    {
+        callback(badRequest(err));
+        return;
+    }
+
+    writeNode(id, std::move(changes), true, "patch", ifMatch, TraceExporter::requestSpan(req),
+              std::move(callback));
+}
+
+void CulturalNodesCtrl::upsertByKey(const HttpRequestPtr &req,
+                                    std::function<void(const HttpResponsePtr &)> &&callback)
+{
+    auto json = req->getJsonObject();
+    if (!json || !(json->isObject() || json->isArray()))
+    {
+        callback(badRequest("Expected a node object or an array of nodes"));
+        return;
+    }
+    Json::Value rows(Json::arrayValue);
+    if (json->isArray())
+        rows = *json;
+    else
+        rows.append(*json);
+    auto maxRows = static_cast<Json::ArrayIndex>(RuntimeConfig::current().upsertMaxRows);
+    if (rows.size() > maxRows)
+    {
+        callback(badRequest("At most " + std::to_string(maxRows) + " nodes per request"));
+        return;
+    }
+
+    // (name, city) -> row; the last row wins for a key that repeats
+    using NaturalKey = std::pair<std::string, std::string>;
+    auto byKey = std::make_shared<std::map<NaturalKey, Json::Value>>();
+    std::vector<std::string> names;
+    std::vector<std::string> cities;
+    for (Json::ArrayIndex i = 0; i < rows.size(); ++i)
+    {
+        auto &row = rows[i];
+        auto where = "Node " + std::to_string(i) + ": ";
+        if (!row.isObject())
+        {
+            callback(badRequest(where + "not an object"));
+            return;
+        }
+        row.removeMember(CulturalNodes::primaryKeyName);
+        row.removeMember(CulturalNodes::Cols::_version);
+        if (!row[CulturalNodes::Cols::_name].isString() ||
+            !row[CulturalNodes::Cols::_city].isString())
+        {
+            // A null in either would never match the unique (name, city) key
+            callback(badRequest(where + "name and city are required and must not be null"));
+            return;
+        }
+        normalizeJsonColumns(row);
+        std::string err;
+        if (!CulturalNodes::validateJsonForCreation(row, err))
+        {
+            callback(badRequest(where + err));
+            return;
+        }
+        names.push_back(row[CulturalNodes::Cols::_name].asString());
+        cities.push_back(row[CulturalNodes::Cols::_city].asString());
+        (*byKey)[{names.back(), cities.back()}] = std::move(row);
+    }
+
+    auto respond = [callback](size_t inserted, size_t updated, size_t unchanged) {
+        Json::Value body;
+        body["inserted"] = static_cast<Json::UInt64>(inserted);
+        body["updated"] = static_cast<Json::UInt64>(updated);
+        body["unchanged"] = static_cast<Json::UInt64>(unchanged);
+        callback(HttpResponse::newHttpJsonResponse(body));
+    };
+    if (byKey->empty())
+    {
+        respond(0, 0, 0);
+        return;
+    }
+
+    // One read finds every existing row (a superset: name and city are
+    // matched separately, pairs are checked below), so unchanged rows are
+    // never written and the counts don't depend on driver row-count flags.
+    // The read and every write share one transaction: a failed chunk leaves
+    // nothing applied.
+    auto criteria =
+        Criteria(CulturalNodes::Cols::_name, CompareOperator::In, std::move(names)) &&
+        Criteria(CulturalNodes::Cols::_city, CompareOperator::In, std::move(cities));
+    auto span = TraceExporter::requestSpan(req);
     auto client = app().getDbClient();
-    auto mapper = std::make_shared<Mapper<CulturalNodes>>(client);
+    client->newTransactionAsync([callback, criteria, span, byKey, respond](
+                                    const std::shared_ptr<Transaction> &trans) {
+        if (!trans)
+        {
+            callback(internalError());
+            return;
+        }
 
-    mapper->deleteByPrimaryKey(
-        id,
-        [callback, mapper](size_t count)
+        struct Outcome
         {
-            if (count == 0)
+            size_t inserted{0}, updated{0}, unchanged{0};
+            std::vector<NodeId> touched;
+        };
+        auto outcome = std::make_shared<Outcome>();
+        // Answered once: 500 on the first failure, or the counts when the
+        // commit succeeds (after the last statement releases the transaction)
+        auto responded = std::make_shared<std::atomic<bool>>(false);
+        auto fail = [callback, responded](const std::shared_ptr<Transaction> &trans,
+                                          const DrogonDbException &e) {
+            LOG_ERROR << "DB error: " << e.base().what();
+            trans->rollback();
+            if (!responded->exchange(true))
+                callback(internalError());
+        };
+        trans->setCommitCallback([callback, responded, respond, outcome](bool committed) {
+            if (responded->exchange(true))
+                return;
+            if (!committed)
             {
-                auto resp = HttpResponse::newHttpResponse();
-                resp->setStatusCode(k404NotFound);
-                callback(resp);
+                callback(internalError());
                 return;
             }
-            auto resp = HttpResponse::newHttpResponse();
-            resp->setStatusCode(k204NoContent);
-            callback(resp);
-        },
-        [callback, mapper](const DrogonDbException &e)
+            for (auto id : outcome->touched)
+                invalidateNode(id);
+            // Inserted rows change list pages too
+            writeCommitted();
+            respond(outcome->inserted, outcome->updated, outcome->unchanged);
+        });
+
+        auto mapper = std::make_shared<Mapper<CulturalNodes>>(trans);
+        auto query = DbStats::start("cultural_nodes", "find_by_key", span);
+        mapper->findBy(
+            criteria,
+            [trans, mapper, query, span, byKey, outcome, fail](std::vector<CulturalNodes> existing)
+            {
+                query.done(true);
+                std::map<NaturalKey, std::pair<NodeId, Json::Value>> current;
+                for (auto &node : existing)
+                    current.emplace(NaturalKey{node.getValueOfName(), node.getValueOfCity()},
+                                    std::make_pair(node.getPrimaryKey(), node.toJson()));
+
+                // Rows to write, grouped by the columns they set: one
+                // statement per column list, since a multi-row INSERT shares one
+                std::map<std::vector<std::string>, std::vector<const Json::Value *>> groups;
+                for (const auto &[key, row] : *byKey)
+                {
+                    std::vector<std::string> columns;
+                    bool changed = false;
+                    auto it = current.find(key);
+                    for (size_t i = 0; i < CulturalNodes::getColumnNumber(); ++i)
+                    {
+                        const auto &column = CulturalNodes::getColumnName(i);
+                        if (column == CulturalNodes::primaryKeyName ||
+                            column == CulturalNodes::Cols::_version || !row.isMember(column))
+                            continue;
+                        columns.push_back(column);
+                        if (it != current.end() &&
+                            !sameValue(column, row[column], it->second.second[column]))
+                            changed = true;
+                    }
+                    if (it == current.end())
+                        ++outcome->inserted;
+                    else if (changed)
+                    {
+                        ++outcome->updated;
+                        outcome->touched.push_back(it->second.first);
+                    }
+                    else
+                    {
+                        ++outcome->unchanged;
+                        continue;
+                    }
+                    groups[std::move(columns)].push_back(&row);
+                }
+                if (outcome->unchanged > 0)
+                    Metrics::skippedWrites().inc({"upsert"}, outcome->unchanged);
+                // Nothing to write: the empty transaction commits and answers
+
+                for (const auto &[columns, groupRows] : groups)
+                {
+                    auto perStatement = std::max<size_t>(1, kMaxUpsertParameters / columns.size());
+                    for (size_t first = 0; first < groupRows.size(); first += perStatement)
+                    {
+                        auto count = std::min(perStatement, groupRows.size() - first);
+                        auto write = DbStats::start("cultural_nodes", "upsert", span);
+                        auto binder = *trans << upsertSql(trans->type(), columns, count);
+                        for (size_t r = first; r < first + count; ++r)
+                            for (const auto &column : columns)
+                                bindJson(binder, (*groupRows[r])[column]);
+                        binder >> [write](const Result &) { write.done(true); }
+                               >> [trans, fail, write](const DrogonDbException &e)
+                               {
+                                   write.done(false);
+                                   fail(trans, e);
+                               };
+                    }
+                }
+            },
+            [trans, mapper, query, fail](const DrogonDbException &e)
+            {
+                query.done(false);
+                fail(trans, e);
+            });
+    });
+}
+
+void CulturalNodesCtrl::createWithHistory(const HttpRequestPtr &req,
+                                          std::function<void(const HttpResponsePtr &)> &&callback)
+{
+    if (auto *store = app().getPlugin<IdempotencyStore>())
+    {
+        store->handle(req, std::move(callback), [this, req](IdempotencyStore::Callback respond) {
+            insertNodeWithHistory(req, std::move(respond));
+        });
+        return;
+    }
+    insertNodeWithHistory(req, std::move(callback));
+}
+
+void CulturalNodesCtrl::insertNodeWithHistory(const HttpRequestPtr &req,
+                                              std::function<void(const HttpResponsePtr &)> &&callback)
+{
+    auto json = req->getJsonObject();
+    if (!json || !json->isObject() || !(*json)["node"].isObject() ||
+        !(*json)["history"].isArray())
+    {
+        callback(badRequest("Expected {\"node\": {...}, \"history\": [...]}"));
+        return;
+    }
+
+    auto node = (*json)["node"];
+    node.removeMember(CulturalNodes::primaryKeyName);
+    node.removeMember(CulturalNodes::Cols::_version);
+    normalizeJsonColumns(node);
+    std::string err;
+    if (!CulturalNodes::validateJsonForCreation(node, err))
+    {
+        callback(badRequest("node: " + err));
+        return;
+    }
+
+    const auto &history = (*json)["history"];
+    auto maxRows = static_cast<Json::ArrayIndex>(RuntimeConfig::current().historyMaxRows);
+    if (history.size() > maxRows)
+    {
+        callback(badRequest("At most " + std::to_string(maxRows) + " history rows per request"));
+        return;
+    }
+    // Every history row binds the same columns (missing ones as NULL) so
+    // they share multi-row statements; node_id is filled in once known
+    std::vector<std::string> historyColumns;
+    for (size_t i = 0; i < ProfessionalHistory::getColumnNumber(); ++i)
+    {
+        const auto &column = ProfessionalHistory::getColumnName(i);
+        if (column != ProfessionalHistory::primaryKeyName &&
+            column != ProfessionalHistory::Cols::_version)
+            historyColumns.push_back(column);
+    }
+    std::vector<Json::Value> historyRows;
+    historyRows.reserve(history.size());
+    for (Json::ArrayIndex i = 0; i < history.size(); ++i)
+    {
+        auto row = history[i];
+        auto where = "history " + std::to_string(i) + ": ";
+        if (!row.isObject())
         {
+            callback(badRequest(where + "not an object"));
+            return;
+        }
+        row.removeMember(ProfessionalHistory::primaryKeyName);
+        row.removeMember(ProfessionalHistory::Cols::_version);
+        row[ProfessionalHistory::Cols::_node_id] = 0;
+        if (!ProfessionalHistory::validateJsonForCreation(row, err))
+        {
+            callback(badRequest(where + err));
+            return;
+        }
+        historyRows.push_back(std::move(row));
+    }
+
+    std::vector<std::string> nodeColumns;
+    for (size_t i = 0; i < CulturalNodes::getColumnNumber(); ++i)
+    {
+        const auto &column = CulturalNodes::getColumnName(i);
+        if (column != CulturalNodes::primaryKeyName && column != CulturalNodes::Cols::_version &&
+            node.isMember(column))
+            nodeColumns.push_back(column);
+    }
+
+    auto span = TraceExporter::requestSpan(req);
+    auto client = app().getDbClient();
+    client->newTransactionAsync([callback,
+                                 span,
+                                 node = std::move(node),
+                                 nodeColumns = std::move(nodeColumns),
+                                 historyColumns = std::move(historyColumns),
+                                 historyRows = std::move(historyRows)](
+                                    const std::shared_ptr<Transaction> &trans) {
+        if (!trans)
+        {
+            callback(internalError());
+            return;
+        }
+
+        // Answered once: 500 on the first failure, or 201 when the commit
+        // succeeds (after the last statement releases the transaction)
+        auto responded = std::make_shared<std::atomic<bool>>(false);
+        auto created = std::make_shared<Json::Value>(node);
+        auto fail = [callback, responded](const std::shared_ptr<Transaction> &trans,
+                                          const DrogonDbException &e) {
             LOG_ERROR << "DB error: " << e.base().what();
-            Json::Value errBody;
-            errBody["error"] = "Internal server error";
-            auto resp = HttpResponse::newHttpJsonResponse(errBody);
-            resp->setStatusCode(k500InternalServerError);
+            trans->rollback();
+            if (!responded->exchange(true))
+                callback(internalError());
+        };
+        trans->setCommitCallback([callback, responded, created, count = historyRows.size()](
+                                     bool committed) {
+            if (responded->exchange(true))
+                return;
+            if (!committed)
+            {
+                callback(internalError());
+                return;
+            }
+            writeCommitted();
+            Json::Value body;
+            body["node"] = *created;
+            body["history_inserted"] = static_cast<Json::UInt64>(count);
+            auto resp = HttpResponse::newHttpJsonResponse(body);
+            resp->setStatusCode(k201Created);
             callback(resp);
         });
-}
\ No newline at end of file
+
+        auto insertNode = DbStats::start("cultural_nodes", "insert", span);
+        auto binder = *trans << insertSql(CulturalNodes::tableName, nodeColumns, 1);
+        for (const auto &column : nodeColumns)
+            bindJson(binder, node[column]);
+        binder >> [trans, span, fail, created, insertNode, historyColumns, historyRows](
+                      const Result &result)
+               {
+                   insertNode.done(true);
+                   // The row id from the insert itself, as Mapper::insert does
+                   // through updateId(), without reading the row back
+                   auto nodeId = static_cast<NodeId>(result.insertId());
+                   CulturalNodes inserted(*created);
+                   inserted.setId(nodeId);
+                   inserted.setVersion(1);
+                   *created = inserted.toJson();
+
+                   auto perStatement = kMaxUpsertParameters / historyColumns.size();
+                   for (size_t first = 0; first < historyRows.size(); first += perStatement)
+                   {
+                       auto count = std::min(perStatement, historyRows.size() - first);
+                       auto insertHistory =
+                           DbStats::start("professional_history", "insert_many", span);
+                       auto rows = *trans << insertSql(ProfessionalHistory::tableName,
+                                                       historyColumns,
+                                                       count);
+                       for (size_t r = first; r < first + count; ++r)
+                       {
+                           for (const auto &column : historyColumns)
+                           {
+                               if (column == ProfessionalHistory::Cols::_node_id)
+                                   rows << nodeId;
+                               else
+                                   bindJson(rows, historyRows[r][column]);
+                           }
+                       }
+                       rows >> [insertHistory](const Result &) { insertHistory.done(true); }
+                            >> [trans, fail, insertHistory](const DrogonDbException &e)
+                            {
+                                insertHistory.done(false);
+                                fail(trans, e);
+                            };
+                   }
+               }
+               >> [trans, fail, insertNode](const DrogonDbException &e)
+               {
+                   insertNode.done(false);
+                   fail(trans, e);
+               };
+    });
+}
+
+void CulturalNodesCtrl::bulkPatch(const HttpRequestPtr &req,
+                                  std::function<void(const HttpResponsePtr &)> &&callback)
+{
+    auto json = req->getJsonObject();
+    if (!json || !json->isObject() || !(*json)["set"].isObject())
+    {
+        callback(badRequest("Expected {\"ids\": [...] or \"filter\": {...}, \"set\": {...}}"));
+        return;
+    }
+
+    auto job = std::make_shared<BulkJob>();
+    auto err = BulkTarget::parse(*json, bulkFilterColumns(), job->ids, job->filter);
+    if (!err.empty())
+    {
+        callback(badRequest(err));
+        return;
+    }
+
+    auto changes = (*json)["set"];
+    if (changes.isMember(CulturalNodes::primaryKeyName))
+    {
+        callback(badRequest("set cannot change id"));
+        return;
+    }
+    changes.removeMember(CulturalNodes::Cols::_version);
+    normalizeJsonColumns(changes);
+    // Only the fields present are validated
+    changes[CulturalNodes::primaryKeyName] = 0;
+    if (!CulturalNodes::validateJsonForUpdate(changes, err))
+    {
+        callback(badRequest(err));
+        return;
+    }
+
+    // Known columns only: the names end up in the SQL text
+    job->values = Json::Value(Json::objectValue);
+    for (size_t i = 0; i < CulturalNodes::getColumnNumber(); ++i)
+    {
+        const auto &column = CulturalNodes::getColumnName(i);
+        if (column != CulturalNodes::primaryKeyName && column != CulturalNodes::Cols::_version &&
+            changes.isMember(column))
+            job->values[column] = changes[column];
+    }
+    if (job->values.empty())
+    {
+        callback(badRequest("set names no updatable field"));
+        return;
+    }
+
+    job->span = TraceExporter::requestSpan(req);
+    job->callback = std::move(callback);
+    startBulk(std::move(job));
+}
+
+void CulturalNodesCtrl::bulkRemove(const HttpRequestPtr &req,
+                                   std::function<void(const HttpResponsePtr &)> &&callback)
+{
+    auto json = req->getJsonObject();
+    if (!json || !json->isObject())
+    {
+        callback(badRequest("Expected {\"ids\": [...]} or {\"filter\": {...}}"));
+        return;
+    }
+
+    auto job = std::make_shared<BulkJob>();
+    auto err = BulkTarget::parse(*json, bulkFilterColumns(), job->ids, job->filter);
+    if (!err.empty())
+    {
+        callback(badRequest(err));
+        return;
+    }
+    job->span = TraceExporter::requestSpan(req);
+    job->callback = std::move(callback);
+    startBulk(std::move(job));
+}
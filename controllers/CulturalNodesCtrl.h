@@ -8,10 +8,17 @@ class CulturalNodesCtrl : public drogon::HttpController<CulturalNodesCtrl>
 public:
     METHOD_LIST_BEGIN
     ADD_METHOD_TO(CulturalNodesCtrl::getAll, "/cultural_nodes", drogon::Get);
+    // Registered before /cultural_nodes/{1} so the literal path wins
+    ADD_METHOD_TO(CulturalNodesCtrl::lookup, "/cultural_nodes/lookup", drogon::Post);
+    ADD_METHOD_TO(CulturalNodesCtrl::upsertByKey, "/cultural_nodes/by-key", drogon::Put, "JwtAuthFilter");
+    ADD_METHOD_TO(CulturalNodesCtrl::createWithHistory, "/cultural_nodes/with-history", drogon::Post, "JwtAuthFilter");
+    ADD_METHOD_TO(CulturalNodesCtrl::bulkPatch, "/cultural_nodes/bulk", drogon::Patch, "JwtAuthFilter");
+    ADD_METHOD_TO(CulturalNodesCtrl::bulkRemove, "/cultural_nodes/bulk", drogon::Delete, "JwtAuthFilter");
     ADD_METHOD_TO(CulturalNodesCtrl::getOne, "/cultural_nodes/{1}", drogon::Get);
-    ADD_METHOD_TO(CulturalNodesCtrl::create, "/cultural_nodes", drogon::Post);
-    ADD_METHOD_TO(CulturalNodesCtrl::remove, "/cultural_nodes/{1}", drogon::Delete);
-    ADD_METHOD_TO(CulturalNodesCtrl::update, "/cultural_nodes/{1}", drogon::Put);
+    ADD_METHOD_TO(CulturalNodesCtrl::create, "/cultural_nodes", drogon::Post, "JwtAuthFilter");
+    ADD_METHOD_TO(CulturalNodesCtrl::remove, "/cultural_nodes/{1}", drogon::Delete, "JwtAuthFilter");
+    ADD_METHOD_TO(CulturalNodesCtrl::update, "/cultural_nodes/{1}", drogon::Put, "JwtAuthFilter");
+    ADD_METHOD_TO(CulturalNodesCtrl::patch, "/cultural_nodes/{1}", drogon::Patch, "JwtAuthFilter");
     METHOD_LIST_END
 
     void getAll(const drogon::HttpRequestPtr& req,
@@ -21,6 +28,10 @@ public:
                 std::function<void (const drogon::HttpResponsePtr &)> &&callback,
                 int id);
 
+    /// Multi-get with the id list in a JSON body: {"ids": [1, 5, 9]}
+    void lookup(const drogon::HttpRequestPtr& req,
+                std::function<void (const drogon::HttpResponsePtr &)> &&callback);
+
     void create(const drogon::HttpRequestPtr& req,
                 std::function<void (const drogon::HttpResponsePtr &)> &&callback);
 
@@ -31,4 +42,39 @@ public:
     void update(const drogon::HttpRequestPtr& req,
                 std::function<void (const drogon::HttpResponsePtr &)> &&callback,
                 int id);                
+
+    /// Partial update: writes only the columns that change and returns the row;
+    /// honours If-Match like update and remove
+    void patch(const drogon::HttpRequestPtr& req,
+               std::function<void (const drogon::HttpResponsePtr &)> &&callback,
+               int id);
+
+    /// Insert-or-update one node or an array of nodes on their (name, city) key
+    void upsertByKey(const drogon::HttpRequestPtr& req,
+                     std::function<void (const drogon::HttpResponsePtr &)> &&callback);
+
+    /// Node plus its professional history in one transaction:
+    /// {"node": {...}, "history": [{...}, ...]}
+    void createWithHistory(const drogon::HttpRequestPtr& req,
+                           std::function<void (const drogon::HttpResponsePtr &)> &&callback);
+
+    /// Same field values for many nodes, chosen by {"ids": [...]} or by a
+    /// whitelisted {"filter": {...}}: {"ids": [1, 2], "set": {"sort": "venue"}}
+    void bulkPatch(const drogon::HttpRequestPtr& req,
+                   std::function<void (const drogon::HttpResponsePtr &)> &&callback);
+
+    /// Delete the nodes chosen by {"ids": [...]} or {"filter": {...}}
+    void bulkRemove(const drogon::HttpRequestPtr& req,
+                    std::function<void (const drogon::HttpResponsePtr &)> &&callback);
+
+private:
+    void insertNode(const drogon::HttpRequestPtr& req,
+                    std::function<void (const drogon::HttpResponsePtr &)> &&callback);
+    void insertNodeWithHistory(const drogon::HttpRequestPtr& req,
+                               std::function<void (const drogon::HttpResponsePtr &)> &&callback);
+
+    /// Rows for @p ids in request order, null for ids without a row
+    void getMany(const drogon::HttpRequestPtr& req,
+                 std::function<void (const drogon::HttpResponsePtr &)> &&callback,
+                 std::vector<int> ids);
 };
\ No newline at end of file
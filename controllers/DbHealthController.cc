@@ -2,54 +2,146 @@
 #include "DbHealthController.h"
 #include <drogon/HttpAppFramework.h>
 #include <drogon/orm/DbClient.h>
+#include "utils/DbStats.h"
+#include "utils/RuntimeConfig.h"
+#include "utils/Startup.h"
+#include <mutex>
+#include <optional>
+
+namespace
+{
+struct ProbeResult
+{
+    bool ok{false};
+    std::string message;
+    int64_t latencyUs{0};
+    int64_t checkedAtUs{0};
+};
+
+using ProbeCallback = std::function<void(const ProbeResult &, bool cached)>;
+
+// Serves the last probe result while it is fresh and lets concurrent
+// callers share a single in-flight probe, so load balancer polling never
+// turns into more than one query per TTL.
+class ProbeCache
+{
+  public:
+    void get(ProbeCallback &&callback)
+    {
+        const int64_t ttlUs = RuntimeConfig::current().dbHealthCacheTtlMs * 1000;
+
+        std::unique_lock<std::mutex> lock(mutex_);
+        if (last_ && DbStats::nowUs() - last_->checkedAtUs < ttlUs)
+        {
+            auto result = *last_;
+            lock.unlock();
+            callback(result, true);
+            return;
+        }
+
+        waiters_.push_back(std::move(callback));
+        if (probing_)
+            return;
+        probing_ = true;
+        lock.unlock();
+        probe();
+    }
+
+  private:
+    void probe()
+    {
+        auto db = drogon::app().getDbClient("default");
+        if (!db)
+        {
+            finish({false, "No database client available", 0, DbStats::nowUs()});
+            return;
+        }
+
+        auto query = DbStats::start("health", "ping");
+        auto startUs = DbStats::nowUs();
+        db->execSqlAsync(
+            "SELECT 1",
+            [this, query, startUs](const drogon::orm::Result &) {
+                query.done(true);
+                auto now = DbStats::nowUs();
+                finish({true, "Database connection is healthy", now - startUs, now});
+            },
+            [this, query, startUs](const drogon::orm::DrogonDbException &e) {
+                query.done(false);
+                LOG_ERROR << "DB health check failed: " << e.base().what();
+                auto now = DbStats::nowUs();
+                finish({false,
+                        std::string("Database query failed: ") + e.base().what(),
+                        now - startUs,
+                        now});
+            });
+    }
+
+    void finish(ProbeResult &&result)
+    {
+        std::vector<ProbeCallback> waiters;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            last_ = result;
+            probing_ = false;
+            waiters.swap(waiters_);
+        }
+        for (auto &waiter : waiters)
+            waiter(result, false);
+    }
+
+    std::mutex mutex_;
+    std::optional<ProbeResult> last_;
+    std::vector<ProbeCallback> waiters_;
+    bool probing_{false};
+};
+
+ProbeCache &probeCache()
+{
+    static ProbeCache cache;
+    return cache;
+}
+}  // namespace
 
 void DbHealthController::check(const drogon::HttpRequestPtr &req,
                                 std::function<void(const drogon::HttpResponsePtr &)> &&callback) const
 {
-    auto db = drogon::app().getDbClient("default");
-    
-    if (!db)
-    {
+    bool deep = req->getParameter("deep") == "1";
+
+    probeCache().get([callback = std::move(callback), deep](const ProbeResult &probe,
+                                                            bool cached) {
         Json::Value res;
-        res["status"] = "error";
-        res["message"] = "No database client available";
-        auto resp = drogon::HttpResponse::newHttpJsonResponse(res);
-        resp->setStatusCode(drogon::k503ServiceUnavailable);
-        callback(resp);
-        return;
-    }
+        res["status"] = probe.ok ? "ok" : "error";
+        res["message"] = probe.message;
+        res["latency_us"] = static_cast<Json::Int64>(probe.latencyUs);
+        res["cached"] = cached;
 
-    // Run SHOW TABLES to verify connection and get table list
-    db->execSqlAsync(
-        "SHOW TABLES",
-        [callback](const drogon::orm::Result &result)
+        if (deep)
         {
-            Json::Value tables(Json::arrayValue);
-            for (const auto &row : result)
+            auto clients = DbStats::toJson();
+            for (const auto &name : clients.getMemberNames())
             {
-                tables.append(row[0].as<std::string>());
+                // Only clients declared in config.json exist in the framework
+                if (clients[name]["connections"].asInt64() == 0)
+                    continue;
+                auto db = drogon::app().getDbClient(name);
+                clients[name]["available"] = db && db->hasAvailableConnections();
             }
+            res["clients"] = clients;
+        }
 
-            Json::Value res;
-            res["status"] = "ok";
-            res["message"] = "Database connection is healthy";
-            res["table_count"] = static_cast<int>(tables.size());
-            res["tables"] = tables;
-
-            auto resp = drogon::HttpResponse::newHttpJsonResponse(res);
-            resp->setStatusCode(drogon::k200OK);
-            callback(resp);
-        },
-        [callback](const drogon::orm::DrogonDbException &e)
-        {
-            LOG_ERROR << "DB health check failed: " << e.base().what();
-
-            Json::Value res;
-            res["status"] = "error";
-            res["message"] = std::string("Database query failed: ") + e.base().what();
+        auto resp = drogon::HttpResponse::newHttpJsonResponse(res);
+        resp->setStatusCode(probe.ok ? drogon::k200OK : drogon::k503ServiceUnavailable);
+        callback(resp);
+    });
+}
 
-            auto resp = drogon::HttpResponse::newHttpJsonResponse(res);
-            resp->setStatusCode(drogon::k503ServiceUnavailable);
-            callback(resp);
-        });
-}
\ No newline at end of file
+void DbHealthController::ready(const drogon::HttpRequestPtr &,
+                               std::function<void(const drogon::HttpResponsePtr &)> &&callback) const
+{
+    auto status = Startup::status();
+    auto resp = drogon::HttpResponse::newHttpJsonResponse(status);
+    resp->setStatusCode(status["ready"].asBool() ? drogon::k200OK
+                                                 : drogon::k503ServiceUnavailable);
+    callback(resp);
+}
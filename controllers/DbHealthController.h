@@ -6,8 +6,15 @@ class DbHealthController : public drogon::HttpController<DbHealthController>
 public:
     METHOD_LIST_BEGIN
         ADD_METHOD_TO(DbHealthController::check, "/health/db", drogon::Get);
+        ADD_METHOD_TO(DbHealthController::ready, "/health/ready", drogon::Get);
     METHOD_LIST_END
 
+    // GET /health/db          liveness (SELECT 1, cached for a short TTL)
+    // GET /health/db?deep=1   plus per-client pool usage and latency percentiles
     void check(const drogon::HttpRequestPtr &req,
                std::function<void(const drogon::HttpResponsePtr &)> &&callback) const;
-};
\ No newline at end of file
+
+    // GET /health/ready       503 until startup warm-up has completed
+    void ready(const drogon::HttpRequestPtr &req,
+               std::function<void(const drogon::HttpResponsePtr &)> &&callback) const;
+};
@@ -1,17 +1,125 @@
 #include "EchoWebsock.h"
+#include <drogon/HttpAppFramework.h>
+#include "plugins/WsConnectionRegistry.h"
+#include "utils/WsDeflate.h"
+
+namespace
+{
+struct DeflateSettings
+{
+    bool enabled{false};
+    WsDeflateCodec::Options options;
+};
+
+// custom_config.websocket.deflate in config.json
+const DeflateSettings &deflateSettings()
+{
+    static const DeflateSettings settings = []() {
+        DeflateSettings s;
+        const auto &cfg =
+            drogon::app().getCustomConfig()["websocket"]["deflate"];
+        s.enabled = cfg.get("enabled", false).asBool();
+        s.options.contextTakeover = cfg.get("context_takeover", true).asBool();
+        s.options.level = cfg.get("level", 6).asInt();
+        s.options.windowBits = cfg.get("window_bits", 15).asInt();
+        s.options.memLevel = cfg.get("mem_level", 8).asInt();
+        s.options.minSize = cfg.get("min_size", 256).asUInt64();
+        s.options.maxMessageSize =
+            cfg.get("max_message_size", 16 * 1024 * 1024).asUInt64();
+        return s;
+    }();
+    return settings;
+}
+
+// Without context takeover the codec is reset after every message, so one
+// instance per IO thread serves all of that thread's connections.
+WsDeflateCodec &threadCodec()
+{
+    thread_local WsDeflateCodec codec(deflateSettings().options);
+    return codec;
+}
+
+// Attached as the connection context when the client opted in to the
+// deflate envelope; a null codec means the thread codec is used.
+struct WsSession
+{
+    std::unique_ptr<WsDeflateCodec> codec;
+
+    WsDeflateCodec &deflater()
+    {
+        return codec ? *codec : threadCodec();
+    }
+};
+
+// Plugins are created by the framework before any connection is accepted,
+// so the lookup is done once and cached.
+WsConnectionRegistry *registry()
+{
+    static auto *instance = drogon::app().getPlugin<WsConnectionRegistry>();
+    return instance;
+}
+}  // namespace
 
 void EchoWebsock::handleNewMessage(const drogon::WebSocketConnectionPtr& wsConnPtr, std::string &&message, const drogon::WebSocketMessageType &type)
 {
-    // write your application logic here
-    wsConnPtr->send(message);
+    // Ping/pong/close are answered by the framework
+    if (type != drogon::WebSocketMessageType::Text &&
+        type != drogon::WebSocketMessageType::Binary)
+        return;
+
+    if (auto *reg = registry())
+        reg->touch(wsConnPtr);
+
+    auto session = wsConnPtr->getContext<WsSession>();
+    if (!session)
+    {
+        wsConnPtr->send(message, type);
+        return;
+    }
+
+    // Enveloped clients may still send plain text frames
+    auto &codec = session->deflater();
+    std::string payload;
+    bool isText = true;
+    if (type == drogon::WebSocketMessageType::Text)
+    {
+        payload = std::move(message);
+    }
+    else if (!codec.decode(message, payload, isText))
+    {
+        wsConnPtr->shutdown(drogon::CloseCode::kProtocolError,
+                            "invalid deflate envelope");
+        return;
+    }
+
+    std::string frame;
+    if (!codec.encode(payload, isText, frame))
+    {
+        wsConnPtr->shutdown(drogon::CloseCode::kUnexpectedCondition,
+                            "compression failed");
+        return;
+    }
+    wsConnPtr->send(frame, drogon::WebSocketMessageType::Binary);
 }
 
 void EchoWebsock::handleNewConnection(const drogon::HttpRequestPtr &req, const drogon::WebSocketConnectionPtr& wsConnPtr)
 {
-    // write your application logic here
+    if (auto *reg = registry())
+        reg->add(wsConnPtr);
+
+    // Opt in with ws://host/echo?compress=deflate
+    const auto &settings = deflateSettings();
+    if (settings.enabled && req->getParameter("compress") == "deflate")
+    {
+        auto session = std::make_shared<WsSession>();
+        if (settings.options.contextTakeover)
+            session->codec = std::make_unique<WsDeflateCodec>(settings.options);
+        wsConnPtr->setContext(session);
+    }
 }
 
 void EchoWebsock::handleConnectionClosed(const drogon::WebSocketConnectionPtr& wsConnPtr)
 {
-    // write your application logic here
+    if (auto *reg = registry())
+        reg->remove(wsConnPtr);
 }
@@ -1,11 +1,14 @@
 #include "TestCtrl.h"
 #include <drogon/HttpResponse.h>
+#include "utils/Startup.h"
 #include <fstream>
 #include <sstream>
 
-// Read HTML file once at startup
+// Read HTML file once, on first use rather than during static
+// initialization, and relative to the config directory rather than the
+// working directory
 static std::string loadIndexHTML() {
-    std::ifstream file("../public/index.html");
+    std::ifstream file(Startup::resolvePath("public/index.html"));
     if (!file.is_open()) {
         LOG_WARN << "Failed to load index.html, using fallback";
         return "<html><body><h1>Culture Hub API</h1><p>Server is running</p></body></html>";
@@ -15,8 +18,11 @@ static std::string loadIndexHTML() {
     return buffer.str();
 }
 
-// Cache the HTML content
-static const std::string INDEX_HTML = loadIndexHTML();
+const std::string &TestCtrl::indexHtml()
+{
+    static const std::string html = loadIndexHTML();
+    return html;
+}
 
 void TestCtrl::asyncHandleHttpRequest(
     const drogon::HttpRequestPtr& req,
@@ -25,6 +31,6 @@ void TestCtrl::asyncHandleHttpRequest(
     auto resp = drogon::HttpResponse::newHttpResponse();
     resp->setStatusCode(drogon::k200OK);
     resp->setContentTypeCode(drogon::CT_TEXT_HTML);
-    resp->setBody(INDEX_HTML);
+    resp->setBody(indexHtml());
     callback(resp);
 }
\ No newline at end of file
@@ -9,6 +9,9 @@ class TestCtrl : public drogon::HttpSimpleController<TestCtrl>
         std::function<void (const drogon::HttpResponsePtr &)> &&callback
     ) override;
 
+    /// Contents of public/index.html, read on first use (warmed at startup)
+    static const std::string &indexHtml();
+
     PATH_LIST_BEGIN
         PATH_ADD("/", drogon::Get, drogon::Post);
         PATH_ADD("/test", drogon::Get, drogon::Post);
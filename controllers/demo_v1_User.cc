@@ -1,9 +1,48 @@
 #include "demo_v1_User.h"
+#include <drogon/HttpAppFramework.h>
 #include <drogon/HttpResponse.h>
 #include <drogon/utils/Utilities.h>
+#include "plugins/TokenStore.h"
+#include "filters/JwtAuthFilter.h"
+#include "utils/RuntimeConfig.h"
+#include "utils/SecureCompare.h"
+#include <algorithm>
+#include <cctype>
 
 using namespace demo::v1;
 
+static drogon::HttpResponsePtr errorResponse(drogon::HttpStatusCode code,
+                                             const std::string &message)
+{
+    Json::Value ret;
+    ret["result"] = "error";
+    ret["message"] = message;
+    auto resp = drogon::HttpResponse::newHttpJsonResponse(ret);
+    resp->setStatusCode(code);
+    return resp;
+}
+
+// AUTH_USERS entries are "<user>:<salt>:<hex SHA-256 of salt + password>"
+static bool credentialValid(const std::string &userId, const std::string &password)
+{
+    for (const auto &entry : RuntimeConfig::current().authUsers)
+    {
+        auto first = entry.find(':');
+        if (entry.compare(0, first, userId) != 0)
+            continue;
+        auto second = entry.find(':', first + 1);
+        auto expected = entry.substr(second + 1);
+        std::transform(expected.begin(), expected.end(), expected.begin(), [](unsigned char c) {
+            return static_cast<char>(std::toupper(c));
+        });
+        auto salt = entry.substr(first + 1, second - first - 1);
+        return constantTimeEquals(drogon::utils::getSha256(salt + password), expected);
+    }
+    // Hash anyway so an unknown user id is not told apart by timing
+    drogon::utils::getSha256(password);
+    return false;
+}
+
 void User::login(const drogon::HttpRequestPtr &req,
                  std::function<void (const drogon::HttpResponsePtr &)> &&callback,
                  std::string &&userId,
@@ -11,10 +50,34 @@ void User::login(const drogon::HttpRequestPtr &req,
 {
     LOG_DEBUG << "User " << userId << " login";
 
+    if (!credentialValid(userId, password))
+    {
+        callback(errorResponse(drogon::k401Unauthorized, "Invalid user id or password"));
+        return;
+    }
+
+    auto *store = drogon::app().getPlugin<TokenStore>();
+    if (!store)
+    {
+        callback(errorResponse(drogon::k503ServiceUnavailable,
+                               "Token store not configured"));
+        return;
+    }
+
     Json::Value ret;
     ret["result"] = "ok";
     ret["id"] = userId;                     // <-- added id field
-    ret["token"] = drogon::utils::getUuid(); // <-- generated token
+    ret["token"] = store->issue(userId);    // <-- stored, expiring token
+    ret["expires_in"] = static_cast<Json::UInt64>(store->ttl());
+
+    // Signed, stateless token for routes guarded by JwtAuthFilter
+    auto accessToken = JwtAuthFilter::issue(userId);
+    if (!accessToken.empty())
+    {
+        ret["access_token"] = accessToken;
+        ret["token_type"] = "Bearer";
+        ret["access_expires_in"] = static_cast<Json::Int64>(JwtAuthFilter::ttl());
+    }
 
     auto resp = drogon::HttpResponse::newHttpJsonResponse(ret);
     callback(resp);
@@ -25,7 +88,20 @@ void User::getInfo(const drogon::HttpRequestPtr &req,
                    std::string userId,
                    const std::string &token)
 {
-    
+    auto *store = drogon::app().getPlugin<TokenStore>();
+    if (!store)
+    {
+        callback(errorResponse(drogon::k503ServiceUnavailable,
+                               "Token store not configured"));
+        return;
+    }
+
+    if (!store->verify(token, userId))
+    {
+        callback(errorResponse(drogon::k401Unauthorized, "Invalid or expired token"));
+        return;
+    }
+
     Json::Value ret;
     ret["result"] = "ok";
     ret["id"] = userId;     // <-- return id as JSON
@@ -33,4 +109,4 @@ void User::getInfo(const drogon::HttpRequestPtr &req,
 
     auto resp = drogon::HttpResponse::newHttpJsonResponse(ret);
     callback(resp);
-}
\ No newline at end of file
+}
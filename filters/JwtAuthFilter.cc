@@ -0,0 +1,117 @@
+#include "JwtAuthFilter.h"
+#include "utils/RuntimeConfig.h"
+#include "utils/SignedToken.h"
+#include <drogon/HttpAppFramework.h>
+#include <drogon/HttpResponse.h>
+#include <trantor/utils/Date.h>
+#include <cstdint>
+#include <unordered_map>
+
+namespace
+{
+constexpr size_t kCacheCapacity = 4096;
+
+struct VerifiedToken
+{
+    int64_t exp;
+    int64_t nbf;
+    std::string sub;
+};
+
+// Tokens whose signature has been verified on this IO thread. Cleared
+// wholesale when full, and when a new RuntimeConfig is published so a
+// rotated JWT_SECRET stops accepting old tokens; a miss only costs one HMAC.
+std::unordered_map<std::string, VerifiedToken> &verifiedTokens(uint64_t configVersion)
+{
+    thread_local std::unordered_map<std::string, VerifiedToken> cache;
+    thread_local uint64_t cacheVersion = 0;
+    if (cacheVersion != configVersion)
+    {
+        cache.clear();
+        cacheVersion = configVersion;
+    }
+    return cache;
+}
+
+drogon::HttpResponsePtr unauthorized(const std::string &message)
+{
+    Json::Value json;
+    json["result"] = "error";
+    json["message"] = message;
+    auto resp = drogon::HttpResponse::newHttpJsonResponse(json);
+    resp->setStatusCode(drogon::k401Unauthorized);
+    resp->addHeader("WWW-Authenticate", "Bearer");
+    return resp;
+}
+}  // namespace
+
+int64_t JwtAuthFilter::ttl()
+{
+    return RuntimeConfig::current().accessTokenTtl;
+}
+
+std::string JwtAuthFilter::issue(const std::string &subject)
+{
+    const auto &config = RuntimeConfig::current();
+    if (config.jwtSecret.empty())
+        return {};
+
+    auto now = trantor::Date::now().secondsSinceEpoch();
+    Json::Value claims;
+    claims["sub"] = subject;
+    claims["iat"] = static_cast<Json::Int64>(now);
+    claims["exp"] = static_cast<Json::Int64>(now + config.accessTokenTtl);
+    return SignedToken::sign(claims, config.jwtSecret);
+}
+
+void JwtAuthFilter::doFilter(const drogon::HttpRequestPtr &req,
+                             drogon::FilterCallback &&cb,
+                             drogon::FilterChainCallback &&ccb)
+{
+    static const std::string prefix = "Bearer ";
+    const auto &header = req->getHeader("authorization");
+    if (header.size() <= prefix.size() ||
+        header.compare(0, prefix.size(), prefix) != 0)
+    {
+        cb(unauthorized("Missing bearer token"));
+        return;
+    }
+    const auto &config = RuntimeConfig::current();
+    if (config.jwtSecret.empty())
+    {
+        cb(unauthorized("Bearer tokens are not enabled"));
+        return;
+    }
+
+    auto token = header.substr(prefix.size());
+    auto now = trantor::Date::now().secondsSinceEpoch();
+    auto &cache = verifiedTokens(config.version);
+
+    auto it = cache.find(token);
+    if (it == cache.end())
+    {
+        Json::Value claims;
+        std::string err;
+        if (!SignedToken::verify(token, config.jwtSecret, now, claims, err))
+        {
+            cb(unauthorized(err));
+            return;
+        }
+
+        if (cache.size() >= kCacheCapacity)
+            cache.clear();
+        VerifiedToken verified{claims.get("exp", Json::Int64(INT64_MAX)).asInt64(),
+                               claims.get("nbf", Json::Int64(0)).asInt64(),
+                               claims["sub"].asString()};
+        it = cache.emplace(std::move(token), std::move(verified)).first;
+    }
+    else if (it->second.exp <= now || it->second.nbf > now)
+    {
+        cache.erase(it);
+        cb(unauthorized("Token expired"));
+        return;
+    }
+
+    req->attributes()->insert("auth.sub", it->second.sub);
+    ccb();
+}
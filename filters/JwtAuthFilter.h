@@ -0,0 +1,28 @@
+#pragma once
+
+#include <drogon/HttpFilter.h>
+#include <string>
+
+/**
+ * @brief Stateless bearer-token authentication
+ *
+ * Accepts "Authorization: Bearer <token>" where the token was signed by
+ * JwtAuthFilter::issue (HS256, secret from the JWT_SECRET environment
+ * variable). Verification is CPU-only; tokens whose signature was already
+ * checked are remembered in a small per-thread cache so repeated requests
+ * only re-check expiry. The subject is exposed to handlers as the
+ * "auth.sub" request attribute.
+ */
+class JwtAuthFilter : public drogon::HttpFilter<JwtAuthFilter>
+{
+  public:
+    void doFilter(const drogon::HttpRequestPtr &req,
+                  drogon::FilterCallback &&cb,
+                  drogon::FilterChainCallback &&ccb) override;
+
+    /// Sign an access token for @p subject; empty if no secret is configured
+    static std::string issue(const std::string &subject);
+
+    /// Lifetime of issued tokens in seconds (custom_config.auth.access_token_ttl)
+    static int64_t ttl();
+};
@@ -1,4 +1,5 @@
 #include "OriginRejectFilter.h"
+#include "utils/RuntimeConfig.h"
 
 OriginRejectFilter::OriginRejectFilter()
 {
@@ -9,10 +10,10 @@ void OriginRejectFilter::invoke(const drogon::HttpRequestPtr &req,
                                 drogon::MiddlewareCallback &&mcb)
 {
     std::string origin = req->getHeader("origin");
+    const auto &settings = RuntimeConfig::current();
 
     // Reject specific origin
-    if (!origin.empty() &&
-        origin.find("www.some-evil-place.com") != std::string::npos)
+    if (!origin.empty() && settings.originRejected(origin))
     {
         auto resp = drogon::HttpResponse::newHttpResponse();
         resp->setStatusCode(drogon::k403Forbidden);
@@ -20,6 +21,11 @@ void OriginRejectFilter::invoke(const drogon::HttpRequestPtr &req,
         return;
     }
 
+    // Origins outside cors.allowed_origins get no CORS headers, so the
+    // browser blocks the response
+    if (!settings.originAllowed(origin))
+        origin.clear();
+
     // Handle CORS preflight
     if (req->method() == drogon::Options)
     {
@@ -2,6 +2,8 @@
 #include <trantor/utils/Date.h>
 #include <trantor/utils/Logger.h>
 #include <drogon/HttpResponse.h>
+#include "utils/RuntimeConfig.h"
+#include <sstream>
 
 #define VDate "visitDate"
 
@@ -16,7 +18,7 @@ void TimeFilter::doFilter(const drogon::HttpRequestPtr &req,
         return;
     }
 
-    const int minIntervalSec = 10;
+    const double minIntervalSec = RuntimeConfig::current().rateLimitIntervalSec;
 
     auto now = trantor::Date::now();
 
@@ -47,7 +49,9 @@ void TimeFilter::doFilter(const drogon::HttpRequestPtr &req,
         {
             Json::Value json;
             json["result"] = "error";
-            json["message"] = "Access interval should be at least 10 seconds";
+            std::ostringstream message;
+            message << "Access interval should be at least " << minIntervalSec << " seconds";
+            json["message"] = message.str();
             json["elapsed_seconds"] = elapsedSec;
             json["remaining_seconds"] = remainingSec > 0 ? remainingSec : 0.0;
 
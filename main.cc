@@ -1,8 +1,93 @@
 #include <drogon/drogon.h>
+#include "controllers/TestCtrl.h"
+#include "utils/DbStats.h"
+#include "utils/RuntimeConfig.h"
+#include "utils/Startup.h"
+#include <fstream>
+#include <thread>
 
-int main()
+// Retried until it succeeds so /health/ready only flips once the pool
+// actually serves queries. A client listed in db_clients that the framework
+// did not create can never get ready, so startup stops instead.
+static void warmDbClient(const std::string &name, Startup::Done done)
 {
-    drogon::app().loadConfigFile("../config.json");
+    auto db = drogon::app().getDbClient(name);
+    if (!db)
+    {
+        LOG_FATAL << "Warm-up: no db client named " << name;
+        done(false);
+        drogon::app().quit();
+        return;
+    }
+    db->execSqlAsync(
+        "SELECT 1",
+        [done](const drogon::orm::Result &) { done(true); },
+        [name, done](const drogon::orm::DrogonDbException &e) {
+            LOG_WARN << "Warm-up: db client " << name << " not ready: " << e.base().what();
+            drogon::app().getLoop()->runAfter(1.0, [name, done]() { warmDbClient(name, done); });
+        });
+}
+
+int main(int argc, char **argv)
+{
+    Startup::begin();
+
+    std::string configPath;
+    Json::Value config;
+    try
+    {
+        configPath = Startup::resolveConfigPath(argc, argv);
+        std::ifstream in(configPath);
+        Json::CharReaderBuilder builder;
+        std::string errs;
+        if (!Json::parseFromStream(builder, in, &config, &errs))
+            throw std::runtime_error(configPath + ": " + errs);
+    }
+    catch (const std::exception &e)
+    {
+        LOG_FATAL << "Cannot load configuration: " << e.what();
+        return 1;
+    }
+    Startup::phase("config");
+
+    // Parse once so the same document feeds both drogon and DbStats
+    drogon::app().loadConfigJson(config);
+    DbStats::configure(config["db_clients"]);
+
+    // ConfigWatcher, when enabled, republishes this whenever the files change
+    std::vector<std::string> configErrors;
+    auto runtimeConfig =
+        RuntimeConfig::build(config["custom_config"],
+                             RuntimeConfig::loadEnvFile(Startup::resolvePath(".env")),
+                             configErrors);
+    if (!configErrors.empty())
+    {
+        for (const auto &error : configErrors)
+            LOG_FATAL << "Invalid setting: " << error;
+        return 1;
+    }
+    RuntimeConfig::publish(std::move(runtimeConfig));
+    LOG_INFO << "Using " << configPath;
+
+    for (const auto &client : config["db_clients"])
+    {
+        auto name = client.get("name", "default").asString();
+        Startup::addWarmup("db:" + name,
+                           [name](Startup::Done done) { warmDbClient(name, done); });
+    }
+    Startup::addWarmup("index_html", [](Startup::Done done) {
+        std::thread([done]() {
+            TestCtrl::indexHtml();
+            done(true);
+        }).detach();
+    });
+
+    // Runs once listeners, DB clients and plugins are up
+    drogon::app().registerBeginningAdvice([]() {
+        Startup::phase("framework");
+        Startup::runWarmups();
+    });
+
     drogon::app().run();
     return 0;
-}
\ No newline at end of file
+}
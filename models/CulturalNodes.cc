@@ -23,21 +23,23 @@ const std::string CulturalNodes::Cols::_contact = "contact";
 const std::string CulturalNodes::Cols::_address = "address";
 const std::string CulturalNodes::Cols::_city = "city";
 const std::string CulturalNodes::Cols::_country = "country";
+const std::string CulturalNodes::Cols::_version = "version";
 const std::string CulturalNodes::primaryKeyName = "id";
 const bool CulturalNodes::hasPrimaryKey = true;
 const std::string CulturalNodes::tableName = "cultural_nodes";
 
 const std::vector<typename CulturalNodes::MetaData> CulturalNodes::metaData_={
 {"id","int32_t","int",4,1,1,1},
-{"name","std::string","varchar(100)",100,0,0,0},
+{"name","std::string","varchar(100)",100,0,0,1},
 {"sort","std::string","set('venue','university','collective','cultural hub','residence','artist','manager','festival','concert series','label','radio','other')",0,0,0,1},
 {"description","std::string","text",0,0,0,0},
 {"website","std::string","varchar(100)",100,0,0,0},
 {"social","std::string","json",0,0,0,0},
 {"contact","std::string","json",0,0,0,0},
 {"address","std::string","varchar(50)",50,0,0,0},
-{"city","std::string","varchar(20)",20,0,0,0},
-{"country","std::string","varchar(50)",50,0,0,0}
+{"city","std::string","varchar(20)",20,0,0,1},
+{"country","std::string","varchar(50)",50,0,0,0},
+{"version","int32_t","int",4,0,0,1}
 };
 const std::string &CulturalNodes::getColumnName(size_t index) noexcept(false)
 {
@@ -88,11 +90,15 @@ CulturalNodes::CulturalNodes(const Row &r, const ssize_t indexOffset) noexcept
         {
             country_=std::make_shared<std::string>(r["country"].as<std::string>());
         }
+        if(!r["version"].isNull())
+        {
+            version_=std::make_shared<int32_t>(r["version"].as<int32_t>());
+        }
     }
     else
     {
         size_t offset = (size_t)indexOffset;
-        if(offset + 10 > r.size())
+        if(offset + 11 > r.size())
         {
             LOG_FATAL << "Invalid SQL result for this model";
             return;
@@ -148,13 +154,18 @@ CulturalNodes::CulturalNodes(const Row &r, const ssize_t indexOffset) noexcept
         {
             country_=std::make_shared<std::string>(r[index].as<std::string>());
         }
+        index = offset + 10;
+        if(!r[index].isNull())
+        {
+            version_=std::make_shared<int32_t>(r[index].as<int32_t>());
+        }
     }
 
 }
 
 CulturalNodes::CulturalNodes(const Json::Value &pJson, const std::vector<std::string> &pMasqueradingVector) noexcept(false)
 {
-    if(pMasqueradingVector.size() != 10)
+    if(pMasqueradingVector.size() != 11)
     {
         LOG_ERROR << "Bad masquerading vector";
         return;
@@ -239,6 +250,14 @@ CulturalNodes::CulturalNodes(const Json::Value &pJson, const std::vector<std::st
             country_=std::make_shared<std::string>(pJson[pMasqueradingVector[9]].asString());
         }
     }
+    if(!pMasqueradingVector[10].empty() && pJson.isMember(pMasqueradingVector[10]))
+    {
+        dirtyFlag_[10] = true;
+        if(!pJson[pMasqueradingVector[10]].isNull())
+        {
+            version_=std::make_shared<int32_t>((int32_t)pJson[pMasqueradingVector[10]].asInt64());
+        }
+    }
 }
 
 CulturalNodes::CulturalNodes(const Json::Value &pJson) noexcept(false)
@@ -323,12 +342,20 @@ CulturalNodes::CulturalNodes(const Json::Value &pJson) noexcept(false)
             country_=std::make_shared<std::string>(pJson["country"].asString());
         }
     }
+    if(pJson.isMember("version"))
+    {
+        dirtyFlag_[10]=true;
+        if(!pJson["version"].isNull())
+        {
+            version_=std::make_shared<int32_t>((int32_t)pJson["version"].asInt64());
+        }
+    }
 }
 
 void CulturalNodes::updateByMasqueradedJson(const Json::Value &pJson,
                                             const std::vector<std::string> &pMasqueradingVector) noexcept(false)
 {
-    if(pMasqueradingVector.size() != 10)
+    if(pMasqueradingVector.size() != 11)
     {
         LOG_ERROR << "Bad masquerading vector";
         return;
@@ -412,6 +439,14 @@ void CulturalNodes::updateByMasqueradedJson(const Json::Value &pJson,
             country_=std::make_shared<std::string>(pJson[pMasqueradingVector[9]].asString());
         }
     }
+    if(!pMasqueradingVector[10].empty() && pJson.isMember(pMasqueradingVector[10]))
+    {
+        dirtyFlag_[10] = true;
+        if(!pJson[pMasqueradingVector[10]].isNull())
+        {
+            version_=std::make_shared<int32_t>((int32_t)pJson[pMasqueradingVector[10]].asInt64());
+        }
+    }
 }
 
 void CulturalNodes::updateByJson(const Json::Value &pJson) noexcept(false)
@@ -495,6 +530,14 @@ void CulturalNodes::updateByJson(const Json::Value &pJson) noexcept(false)
             country_=std::make_shared<std::string>(pJson["country"].asString());
         }
     }
+    if(pJson.isMember("version"))
+    {
+        dirtyFlag_[10] = true;
+        if(!pJson["version"].isNull())
+        {
+            version_=std::make_shared<int32_t>((int32_t)pJson["version"].asInt64());
+        }
+    }
 }
 
 const int32_t &CulturalNodes::getValueOfId() const noexcept
@@ -757,6 +800,23 @@ void CulturalNodes::setCountryToNull() noexcept
     dirtyFlag_[9] = true;
 }
 
+const int32_t &CulturalNodes::getValueOfVersion() const noexcept
+{
+    static const int32_t defaultValue = int32_t();
+    if(version_)
+        return *version_;
+    return defaultValue;
+}
+const std::shared_ptr<int32_t> &CulturalNodes::getVersion() const noexcept
+{
+    return version_;
+}
+void CulturalNodes::setVersion(const int32_t &pVersion) noexcept
+{
+    version_ = std::make_shared<int32_t>(pVersion);
+    dirtyFlag_[10] = true;
+}
+
 void CulturalNodes::updateId(const uint64_t id)
 {
     id_ = std::make_shared<int32_t>(static_cast<int32_t>(id));
@@ -773,7 +833,8 @@ const std::vector<std::string> &CulturalNodes::insertColumns() noexcept
         "contact",
         "address",
         "city",
-        "country"
+        "country",
+        "version"
     };
     return inCols;
 }
@@ -879,6 +940,17 @@ void CulturalNodes::outputArgs(drogon::orm::internal::SqlBinder &binder) const
             binder << nullptr;
         }
     }
+    if(dirtyFlag_[10])
+    {
+        if(getVersion())
+        {
+            binder << getValueOfVersion();
+        }
+        else
+        {
+            binder << nullptr;
+        }
+    }
 }
 
 const std::vector<std::string> CulturalNodes::updateColumns() const
@@ -920,6 +992,10 @@ const std::vector<std::string> CulturalNodes::updateColumns() const
     {
         ret.push_back(getColumnName(9));
     }
+    if(dirtyFlag_[10])
+    {
+        ret.push_back(getColumnName(10));
+    }
     return ret;
 }
 
@@ -1024,6 +1100,17 @@ void CulturalNodes::updateArgs(drogon::orm::internal::SqlBinder &binder) const
             binder << nullptr;
         }
     }
+    if(dirtyFlag_[10])
+    {
+        if(getVersion())
+        {
+            binder << getValueOfVersion();
+        }
+        else
+        {
+            binder << nullptr;
+        }
+    }
 }
 Json::Value CulturalNodes::toJson() const
 {
@@ -1108,6 +1195,14 @@ Json::Value CulturalNodes::toJson() const
     {
         ret["country"]=Json::Value();
     }
+    if(getVersion())
+    {
+        ret["version"]=getValueOfVersion();
+    }
+    else
+    {
+        ret["version"]=Json::Value();
+    }
     return ret;
 }
 
@@ -1120,7 +1215,7 @@ Json::Value CulturalNodes::toMasqueradedJson(
     const std::vector<std::string> &pMasqueradingVector) const
 {
     Json::Value ret;
-    if(pMasqueradingVector.size() == 10)
+    if(pMasqueradingVector.size() == 11)
     {
         if(!pMasqueradingVector[0].empty())
         {
@@ -1232,6 +1327,17 @@ Json::Value CulturalNodes::toMasqueradedJson(
                 ret[pMasqueradingVector[9]]=Json::Value();
             }
         }
+        if(!pMasqueradingVector[10].empty())
+        {
+            if(getVersion())
+            {
+                ret[pMasqueradingVector[10]]=getValueOfVersion();
+            }
+            else
+            {
+                ret[pMasqueradingVector[10]]=Json::Value();
+            }
+        }
         return ret;
     }
     LOG_ERROR << "Masquerade failed";
@@ -1315,6 +1421,14 @@ Json::Value CulturalNodes::toMasqueradedJson(
     {
         ret["country"]=Json::Value();
     }
+    if(getVersion())
+    {
+        ret["version"]=getValueOfVersion();
+    }
+    else
+    {
+        ret["version"]=Json::Value();
+    }
     return ret;
 }
 
@@ -1330,6 +1444,11 @@ bool CulturalNodes::validateJsonForCreation(const Json::Value &pJson, std::strin
         if(!validJsonOfField(1, "name", pJson["name"], err, true))
             return false;
     }
+    else
+    {
+        err="The name column cannot be null";
+        return false;
+    }
     if(pJson.isMember("sort"))
     {
         if(!validJsonOfField(2, "sort", pJson["sort"], err, true))
@@ -1370,18 +1489,28 @@ bool CulturalNodes::validateJsonForCreation(const Json::Value &pJson, std::strin
         if(!validJsonOfField(8, "city", pJson["city"], err, true))
             return false;
     }
+    else
+    {
+        err="The city column cannot be null";
+        return false;
+    }
     if(pJson.isMember("country"))
     {
         if(!validJsonOfField(9, "country", pJson["country"], err, true))
             return false;
     }
+    if(pJson.isMember("version"))
+    {
+        if(!validJsonOfField(10, "version", pJson["version"], err, true))
+            return false;
+    }
     return true;
 }
 bool CulturalNodes::validateMasqueradedJsonForCreation(const Json::Value &pJson,
                                                        const std::vector<std::string> &pMasqueradingVector,
                                                        std::string &err)
 {
-    if(pMasqueradingVector.size() != 10)
+    if(pMasqueradingVector.size() != 11)
     {
         err = "Bad masquerading vector";
         return false;
@@ -1402,6 +1531,11 @@ bool CulturalNodes::validateMasqueradedJsonForCreation(const Json::Value &pJson,
               if(!validJsonOfField(1, pMasqueradingVector[1], pJson[pMasqueradingVector[1]], err, true))
                   return false;
           }
+        else
+        {
+            err="The " + pMasqueradingVector[1] + " column cannot be null";
+            return false;
+        }
       }
       if(!pMasqueradingVector[2].empty())
       {
@@ -1463,6 +1597,11 @@ bool CulturalNodes::validateMasqueradedJsonForCreation(const Json::Value &pJson,
               if(!validJsonOfField(8, pMasqueradingVector[8], pJson[pMasqueradingVector[8]], err, true))
                   return false;
           }
+        else
+        {
+            err="The " + pMasqueradingVector[8] + " column cannot be null";
+            return false;
+        }
       }
       if(!pMasqueradingVector[9].empty())
       {
@@ -1472,6 +1611,14 @@ bool CulturalNodes::validateMasqueradedJsonForCreation(const Json::Value &pJson,
                   return false;
           }
       }
+      if(!pMasqueradingVector[10].empty())
+      {
+          if(pJson.isMember(pMasqueradingVector[10]))
+          {
+              if(!validJsonOfField(10, pMasqueradingVector[10], pJson[pMasqueradingVector[10]], err, true))
+                  return false;
+          }
+      }
     }
     catch(const Json::LogicError &e)
     {
@@ -1537,13 +1684,18 @@ bool CulturalNodes::validateJsonForUpdate(const Json::Value &pJson, std::string
         if(!validJsonOfField(9, "country", pJson["country"], err, false))
             return false;
     }
+    if(pJson.isMember("version"))
+    {
+        if(!validJsonOfField(10, "version", pJson["version"], err, false))
+            return false;
+    }
     return true;
 }
 bool CulturalNodes::validateMasqueradedJsonForUpdate(const Json::Value &pJson,
                                                      const std::vector<std::string> &pMasqueradingVector,
                                                      std::string &err)
 {
-    if(pMasqueradingVector.size() != 10)
+    if(pMasqueradingVector.size() != 11)
     {
         err = "Bad masquerading vector";
         return false;
@@ -1604,6 +1756,11 @@ bool CulturalNodes::validateMasqueradedJsonForUpdate(const Json::Value &pJson,
           if(!validJsonOfField(9, pMasqueradingVector[9], pJson[pMasqueradingVector[9]], err, false))
               return false;
       }
+      if(!pMasqueradingVector[10].empty() && pJson.isMember(pMasqueradingVector[10]))
+      {
+          if(!validJsonOfField(10, pMasqueradingVector[10], pJson[pMasqueradingVector[10]], err, false))
+              return false;
+      }
     }
     catch(const Json::LogicError &e)
     {
@@ -1640,7 +1797,8 @@ bool CulturalNodes::validJsonOfField(size_t index,
         case 1:
             if(pJson.isNull())
             {
-                return true;
+                err="The " + fieldName + " column cannot be null";
+                return false;
             }
             if(!pJson.isString())
             {
@@ -1742,7 +1900,8 @@ bool CulturalNodes::validJsonOfField(size_t index,
         case 8:
             if(pJson.isNull())
             {
-                return true;
+                err="The " + fieldName + " column cannot be null";
+                return false;
             }
             if(!pJson.isString())
             {
@@ -1777,6 +1936,18 @@ bool CulturalNodes::validJsonOfField(size_t index,
                 return false;
             }
             break;
+        case 10:
+            if(pJson.isNull())
+            {
+                err="The " + fieldName + " column cannot be null";
+                return false;
+            }
+            if(!pJson.isInt())
+            {
+                err="Type error in the "+fieldName+" field";
+                return false;
+            }
+            break;
         default:
             err="Internal error in the server";
             return false;
@@ -54,6 +54,7 @@ class CulturalNodes
         static const std::string _address;
         static const std::string _city;
         static const std::string _country;
+        static const std::string _version;
     };
 
     static const int primaryKeyNumber;
@@ -202,8 +203,16 @@ class CulturalNodes
     void setCountry(std::string &&pCountry) noexcept;
     void setCountryToNull() noexcept;
 
+    /**  For column version  */
+    ///Get the value of the column version, returns the default value if the column is null
+    const int32_t &getValueOfVersion() const noexcept;
+    ///Return a shared_ptr object pointing to the column const value, or an empty shared_ptr object if the column is null
+    const std::shared_ptr<int32_t> &getVersion() const noexcept;
+    ///Set the value of the column version
+    void setVersion(const int32_t &pVersion) noexcept;
+
 
-    static size_t getColumnNumber() noexcept {  return 10;  }
+    static size_t getColumnNumber() noexcept {  return 11;  }
     static const std::string &getColumnName(size_t index) noexcept(false);
 
     Json::Value toJson() const;
@@ -235,6 +244,7 @@ class CulturalNodes
     std::shared_ptr<std::string> address_;
     std::shared_ptr<std::string> city_;
     std::shared_ptr<std::string> country_;
+    std::shared_ptr<int32_t> version_;
     struct MetaData
     {
         const std::string colName_;
@@ -246,7 +256,7 @@ class CulturalNodes
         const bool notNull_;
     };
     static const std::vector<MetaData> metaData_;
-    bool dirtyFlag_[10]={ false };
+    bool dirtyFlag_[11]={ false };
   public:
     static const std::string &sqlForFindingByPrimaryKey()
     {
@@ -311,6 +321,8 @@ class CulturalNodes
             sql += "country,";
             ++parametersCount;
         }
+        sql += "version,";
+        ++parametersCount;
         needSelection=true;
         if(parametersCount > 0)
         {
@@ -320,7 +332,7 @@ class CulturalNodes
         else
             sql += ") values (";
 
-        sql +="default,";
+        sql +="null,";
         if(dirtyFlag_[1])
         {
             sql.append("?,");
@@ -366,6 +378,14 @@ class CulturalNodes
             sql.append("?,");
 
         }
+        if(dirtyFlag_[10])
+        {
+            sql.append("?,");
+        }
+        else
+        {
+            sql +="1,";
+        }
         if(parametersCount > 0)
         {
             sql.resize(sql.length() - 1);
@@ -20,6 +20,7 @@ const std::string ProfessionalHistory::Cols::_sort = "sort";
 const std::string ProfessionalHistory::Cols::_event_date = "event_date";
 const std::string ProfessionalHistory::Cols::_event_description = "event_description";
 const std::string ProfessionalHistory::Cols::_fee = "fee";
+const std::string ProfessionalHistory::Cols::_version = "version";
 const std::string ProfessionalHistory::primaryKeyName = "id";
 const bool ProfessionalHistory::hasPrimaryKey = true;
 const std::string ProfessionalHistory::tableName = "professional_history";
@@ -31,7 +32,8 @@ const std::vector<typename ProfessionalHistory::MetaData> ProfessionalHistory::m
 {"sort","std::string","set('concert','workshop','conference','exhibitions','residence','other')",0,0,0,1},
 {"event_date","::trantor::Date","date",0,0,0,1},
 {"event_description","std::string","text",0,0,0,0},
-{"fee","std::string","decimal(5,2)",0,0,0,0}
+{"fee","std::string","decimal(5,2)",0,0,0,0},
+{"version","int32_t","int",4,0,0,1}
 };
 const std::string &ProfessionalHistory::getColumnName(size_t index) noexcept(false)
 {
@@ -75,11 +77,15 @@ ProfessionalHistory::ProfessionalHistory(const Row &r, const ssize_t indexOffset
         {
             fee_=std::make_shared<std::string>(r["fee"].as<std::string>());
         }
+        if(!r["version"].isNull())
+        {
+            version_=std::make_shared<int32_t>(r["version"].as<int32_t>());
+        }
     }
     else
     {
         size_t offset = (size_t)indexOffset;
-        if(offset + 7 > r.size())
+        if(offset + 8 > r.size())
         {
             LOG_FATAL << "Invalid SQL result for this model";
             return;
@@ -125,13 +131,18 @@ ProfessionalHistory::ProfessionalHistory(const Row &r, const ssize_t indexOffset
         {
             fee_=std::make_shared<std::string>(r[index].as<std::string>());
         }
+        index = offset + 7;
+        if(!r[index].isNull())
+        {
+            version_=std::make_shared<int32_t>(r[index].as<int32_t>());
+        }
     }
 
 }
 
 ProfessionalHistory::ProfessionalHistory(const Json::Value &pJson, const std::vector<std::string> &pMasqueradingVector) noexcept(false)
 {
-    if(pMasqueradingVector.size() != 7)
+    if(pMasqueradingVector.size() != 8)
     {
         LOG_ERROR << "Bad masquerading vector";
         return;
@@ -197,6 +208,14 @@ ProfessionalHistory::ProfessionalHistory(const Json::Value &pJson, const std::ve
             fee_=std::make_shared<std::string>(pJson[pMasqueradingVector[6]].asString());
         }
     }
+    if(!pMasqueradingVector[7].empty() && pJson.isMember(pMasqueradingVector[7]))
+    {
+        dirtyFlag_[7] = true;
+        if(!pJson[pMasqueradingVector[7]].isNull())
+        {
+            version_=std::make_shared<int32_t>((int32_t)pJson[pMasqueradingVector[7]].asInt64());
+        }
+    }
 }
 
 ProfessionalHistory::ProfessionalHistory(const Json::Value &pJson) noexcept(false)
@@ -262,12 +281,20 @@ ProfessionalHistory::ProfessionalHistory(const Json::Value &pJson) noexcept(fals
             fee_=std::make_shared<std::string>(pJson["fee"].asString());
         }
     }
+    if(pJson.isMember("version"))
+    {
+        dirtyFlag_[7]=true;
+        if(!pJson["version"].isNull())
+        {
+            version_=std::make_shared<int32_t>((int32_t)pJson["version"].asInt64());
+        }
+    }
 }
 
 void ProfessionalHistory::updateByMasqueradedJson(const Json::Value &pJson,
                                             const std::vector<std::string> &pMasqueradingVector) noexcept(false)
 {
-    if(pMasqueradingVector.size() != 7)
+    if(pMasqueradingVector.size() != 8)
     {
         LOG_ERROR << "Bad masquerading vector";
         return;
@@ -332,6 +359,14 @@ void ProfessionalHistory::updateByMasqueradedJson(const Json::Value &pJson,
             fee_=std::make_shared<std::string>(pJson[pMasqueradingVector[6]].asString());
         }
     }
+    if(!pMasqueradingVector[7].empty() && pJson.isMember(pMasqueradingVector[7]))
+    {
+        dirtyFlag_[7] = true;
+        if(!pJson[pMasqueradingVector[7]].isNull())
+        {
+            version_=std::make_shared<int32_t>((int32_t)pJson[pMasqueradingVector[7]].asInt64());
+        }
+    }
 }
 
 void ProfessionalHistory::updateByJson(const Json::Value &pJson) noexcept(false)
@@ -396,6 +431,14 @@ void ProfessionalHistory::updateByJson(const Json::Value &pJson) noexcept(false)
             fee_=std::make_shared<std::string>(pJson["fee"].asString());
         }
     }
+    if(pJson.isMember("version"))
+    {
+        dirtyFlag_[7] = true;
+        if(!pJson["version"].isNull())
+        {
+            version_=std::make_shared<int32_t>((int32_t)pJson["version"].asInt64());
+        }
+    }
 }
 
 const int32_t &ProfessionalHistory::getValueOfId() const noexcept
@@ -552,6 +595,23 @@ void ProfessionalHistory::setFeeToNull() noexcept
     dirtyFlag_[6] = true;
 }
 
+const int32_t &ProfessionalHistory::getValueOfVersion() const noexcept
+{
+    static const int32_t defaultValue = int32_t();
+    if(version_)
+        return *version_;
+    return defaultValue;
+}
+const std::shared_ptr<int32_t> &ProfessionalHistory::getVersion() const noexcept
+{
+    return version_;
+}
+void ProfessionalHistory::setVersion(const int32_t &pVersion) noexcept
+{
+    version_ = std::make_shared<int32_t>(pVersion);
+    dirtyFlag_[7] = true;
+}
+
 void ProfessionalHistory::updateId(const uint64_t id)
 {
     id_ = std::make_shared<int32_t>(static_cast<int32_t>(id));
@@ -565,7 +625,8 @@ const std::vector<std::string> &ProfessionalHistory::insertColumns() noexcept
         "sort",
         "event_date",
         "event_description",
-        "fee"
+        "fee",
+        "version"
     };
     return inCols;
 }
@@ -638,6 +699,17 @@ void ProfessionalHistory::outputArgs(drogon::orm::internal::SqlBinder &binder) c
             binder << nullptr;
         }
     }
+    if(dirtyFlag_[7])
+    {
+        if(getVersion())
+        {
+            binder << getValueOfVersion();
+        }
+        else
+        {
+            binder << nullptr;
+        }
+    }
 }
 
 const std::vector<std::string> ProfessionalHistory::updateColumns() const
@@ -667,6 +739,10 @@ const std::vector<std::string> ProfessionalHistory::updateColumns() const
     {
         ret.push_back(getColumnName(6));
     }
+    if(dirtyFlag_[7])
+    {
+        ret.push_back(getColumnName(7));
+    }
     return ret;
 }
 
@@ -738,6 +814,17 @@ void ProfessionalHistory::updateArgs(drogon::orm::internal::SqlBinder &binder) c
             binder << nullptr;
         }
     }
+    if(dirtyFlag_[7])
+    {
+        if(getVersion())
+        {
+            binder << getValueOfVersion();
+        }
+        else
+        {
+            binder << nullptr;
+        }
+    }
 }
 Json::Value ProfessionalHistory::toJson() const
 {
@@ -798,6 +885,14 @@ Json::Value ProfessionalHistory::toJson() const
     {
         ret["fee"]=Json::Value();
     }
+    if(getVersion())
+    {
+        ret["version"]=getValueOfVersion();
+    }
+    else
+    {
+        ret["version"]=Json::Value();
+    }
     return ret;
 }
 
@@ -810,7 +905,7 @@ Json::Value ProfessionalHistory::toMasqueradedJson(
     const std::vector<std::string> &pMasqueradingVector) const
 {
     Json::Value ret;
-    if(pMasqueradingVector.size() == 7)
+    if(pMasqueradingVector.size() == 8)
     {
         if(!pMasqueradingVector[0].empty())
         {
@@ -889,6 +984,17 @@ Json::Value ProfessionalHistory::toMasqueradedJson(
                 ret[pMasqueradingVector[6]]=Json::Value();
             }
         }
+        if(!pMasqueradingVector[7].empty())
+        {
+            if(getVersion())
+            {
+                ret[pMasqueradingVector[7]]=getValueOfVersion();
+            }
+            else
+            {
+                ret[pMasqueradingVector[7]]=Json::Value();
+            }
+        }
         return ret;
     }
     LOG_ERROR << "Masquerade failed";
@@ -948,6 +1054,14 @@ Json::Value ProfessionalHistory::toMasqueradedJson(
     {
         ret["fee"]=Json::Value();
     }
+    if(getVersion())
+    {
+        ret["version"]=getValueOfVersion();
+    }
+    else
+    {
+        ret["version"]=Json::Value();
+    }
     return ret;
 }
 
@@ -1008,13 +1122,18 @@ bool ProfessionalHistory::validateJsonForCreation(const Json::Value &pJson, std:
         if(!validJsonOfField(6, "fee", pJson["fee"], err, true))
             return false;
     }
+    if(pJson.isMember("version"))
+    {
+        if(!validJsonOfField(7, "version", pJson["version"], err, true))
+            return false;
+    }
     return true;
 }
 bool ProfessionalHistory::validateMasqueradedJsonForCreation(const Json::Value &pJson,
                                                              const std::vector<std::string> &pMasqueradingVector,
                                                              std::string &err)
 {
-    if(pMasqueradingVector.size() != 7)
+    if(pMasqueradingVector.size() != 8)
     {
         err = "Bad masquerading vector";
         return false;
@@ -1096,6 +1215,14 @@ bool ProfessionalHistory::validateMasqueradedJsonForCreation(const Json::Value &
                   return false;
           }
       }
+      if(!pMasqueradingVector[7].empty())
+      {
+          if(pJson.isMember(pMasqueradingVector[7]))
+          {
+              if(!validJsonOfField(7, pMasqueradingVector[7], pJson[pMasqueradingVector[7]], err, true))
+                  return false;
+          }
+      }
     }
     catch(const Json::LogicError &e)
     {
@@ -1146,13 +1273,18 @@ bool ProfessionalHistory::validateJsonForUpdate(const Json::Value &pJson, std::s
         if(!validJsonOfField(6, "fee", pJson["fee"], err, false))
             return false;
     }
+    if(pJson.isMember("version"))
+    {
+        if(!validJsonOfField(7, "version", pJson["version"], err, false))
+            return false;
+    }
     return true;
 }
 bool ProfessionalHistory::validateMasqueradedJsonForUpdate(const Json::Value &pJson,
                                                            const std::vector<std::string> &pMasqueradingVector,
                                                            std::string &err)
 {
-    if(pMasqueradingVector.size() != 7)
+    if(pMasqueradingVector.size() != 8)
     {
         err = "Bad masquerading vector";
         return false;
@@ -1198,6 +1330,11 @@ bool ProfessionalHistory::validateMasqueradedJsonForUpdate(const Json::Value &pJ
           if(!validJsonOfField(6, pMasqueradingVector[6], pJson[pMasqueradingVector[6]], err, false))
               return false;
       }
+      if(!pMasqueradingVector[7].empty() && pJson.isMember(pMasqueradingVector[7]))
+      {
+          if(!validJsonOfField(7, pMasqueradingVector[7], pJson[pMasqueradingVector[7]], err, false))
+              return false;
+      }
     }
     catch(const Json::LogicError &e)
     {
@@ -1309,6 +1446,18 @@ bool ProfessionalHistory::validJsonOfField(size_t index,
                 return false;
             }
             break;
+        case 7:
+            if(pJson.isNull())
+            {
+                err="The " + fieldName + " column cannot be null";
+                return false;
+            }
+            if(!pJson.isInt())
+            {
+                err="Type error in the "+fieldName+" field";
+                return false;
+            }
+            break;
         default:
             err="Internal error in the server";
             return false;
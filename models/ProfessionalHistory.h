@@ -51,6 +51,7 @@ class ProfessionalHistory
         static const std::string _event_date;
         static const std::string _event_description;
         static const std::string _fee;
+        static const std::string _version;
     };
 
     static const int primaryKeyNumber;
@@ -164,8 +165,16 @@ class ProfessionalHistory
     void setFee(std::string &&pFee) noexcept;
     void setFeeToNull() noexcept;
 
+    /**  For column version  */
+    ///Get the value of the column version, returns the default value if the column is null
+    const int32_t &getValueOfVersion() const noexcept;
+    ///Return a shared_ptr object pointing to the column const value, or an empty shared_ptr object if the column is null
+    const std::shared_ptr<int32_t> &getVersion() const noexcept;
+    ///Set the value of the column version
+    void setVersion(const int32_t &pVersion) noexcept;
+
 
-    static size_t getColumnNumber() noexcept {  return 7;  }
+    static size_t getColumnNumber() noexcept {  return 8;  }
     static const std::string &getColumnName(size_t index) noexcept(false);
 
     Json::Value toJson() const;
@@ -194,6 +203,7 @@ class ProfessionalHistory
     std::shared_ptr<::trantor::Date> eventDate_;
     std::shared_ptr<std::string> eventDescription_;
     std::shared_ptr<std::string> fee_;
+    std::shared_ptr<int32_t> version_;
     struct MetaData
     {
         const std::string colName_;
@@ -205,7 +215,7 @@ class ProfessionalHistory
         const bool notNull_;
     };
     static const std::vector<MetaData> metaData_;
-    bool dirtyFlag_[7]={ false };
+    bool dirtyFlag_[8]={ false };
   public:
     static const std::string &sqlForFindingByPrimaryKey()
     {
@@ -255,6 +265,8 @@ class ProfessionalHistory
             sql += "fee,";
             ++parametersCount;
         }
+        sql += "version,";
+        ++parametersCount;
         needSelection=true;
         if(parametersCount > 0)
         {
@@ -264,7 +276,7 @@ class ProfessionalHistory
         else
             sql += ") values (";
 
-        sql +="default,";
+        sql +="null,";
         if(dirtyFlag_[1])
         {
             sql.append("?,");
@@ -295,6 +307,14 @@ class ProfessionalHistory
             sql.append("?,");
 
         }
+        if(dirtyFlag_[7])
+        {
+            sql.append("?,");
+        }
+        else
+        {
+            sql +="1,";
+        }
         if(parametersCount > 0)
         {
             sql.resize(sql.length() - 1);
@@ -0,0 +1,105 @@
+/**
+ *
+ *  ConfigWatcher.cc
+ *
+ */
+
+#include "ConfigWatcher.h"
+#include "utils/RuntimeConfig.h"
+#include "utils/Startup.h"
+#include <drogon/HttpAppFramework.h>
+#include <trantor/utils/Logger.h>
+#include <fstream>
+
+using namespace drogon;
+
+namespace
+{
+// Read once by drogon; edits only take effect after a restart
+const char *const kStartupSections[] = {"listeners", "db_clients", "app", "plugins"};
+}  // namespace
+
+void ConfigWatcher::initAndStart(const Json::Value &config)
+{
+    configPath_ = Startup::configPath();
+    envPath_ = Startup::resolvePath(config.get("env_file", ".env").asString());
+    configStamp_ = stamp(configPath_);
+    envStamp_ = stamp(envPath_);
+
+    std::ifstream in(configPath_);
+    Json::CharReaderBuilder builder;
+    std::string errs;
+    if (!configPath_.empty() && Json::parseFromStream(builder, in, &startupConfig_, &errs))
+        reload();
+
+    loop_ = app().getLoop();
+    timer_ = loop_->runEvery(config.get("interval", 2.0).asDouble(), [this]() { check(); });
+    LOG_INFO << "ConfigWatcher watching " << configPath_ << " and " << envPath_;
+}
+
+void ConfigWatcher::shutdown()
+{
+    if (timer_)
+        loop_->invalidateTimer(timer_);
+}
+
+ConfigWatcher::FileStamp ConfigWatcher::stamp(const std::string &path)
+{
+    FileStamp result;
+    std::error_code ec;
+    auto mtime = std::filesystem::last_write_time(path, ec);
+    if (ec)
+        return result;
+    auto size = std::filesystem::file_size(path, ec);
+    if (ec)
+        return result;
+    result.mtime = mtime;
+    result.size = size;
+    result.exists = true;
+    return result;
+}
+
+void ConfigWatcher::check()
+{
+    auto configStamp = stamp(configPath_);
+    auto envStamp = stamp(envPath_);
+    if (configStamp == configStamp_ && envStamp == envStamp_)
+        return;
+    // A rejected edit is reported once; the next save is picked up as usual
+    configStamp_ = configStamp;
+    envStamp_ = envStamp;
+    reload();
+}
+
+bool ConfigWatcher::reload()
+{
+    Json::Value config;
+    std::ifstream in(configPath_);
+    Json::CharReaderBuilder builder;
+    std::string errs;
+    if (!in || !Json::parseFromStream(builder, in, &config, &errs))
+    {
+        LOG_ERROR << "ConfigWatcher: keeping previous settings, cannot parse " << configPath_
+                  << ": " << errs;
+        return false;
+    }
+
+    std::vector<std::string> errors;
+    auto runtimeConfig = RuntimeConfig::build(config["custom_config"],
+                                              RuntimeConfig::loadEnvFile(envPath_),
+                                              errors);
+    if (!errors.empty())
+    {
+        for (const auto &error : errors)
+            LOG_ERROR << "ConfigWatcher: keeping previous settings, " << error;
+        return false;
+    }
+    auto version = RuntimeConfig::publish(std::move(runtimeConfig));
+
+    for (const char *section : kStartupSections)
+        if (config[section] != startupConfig_[section])
+            LOG_WARN << "ConfigWatcher: \"" << section
+                     << "\" changed in " << configPath_ << ", restart to apply it";
+    LOG_INFO << "ConfigWatcher: published settings version " << version;
+    return true;
+}
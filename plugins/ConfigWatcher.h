@@ -0,0 +1,61 @@
+/**
+ *
+ *  ConfigWatcher.h
+ *
+ */
+
+#pragma once
+
+#include <drogon/plugins/Plugin.h>
+#include <trantor/net/EventLoop.h>
+#include <filesystem>
+#include <string>
+
+/**
+ * @brief Reloads config.json and .env when they change on disk
+ *
+ * Polls both files' modification time and size; on a change it re-parses
+ * them into a fresh RuntimeConfig snapshot and publishes it, so rate
+ * limits, CORS lists, page-size caps, cache TTLs and JWT_SECRET follow the
+ * files without a restart. A file that fails to parse, or a setting that
+ * fails validation, keeps the previous snapshot in place. Sections drogon only reads at startup (listeners,
+ * db_clients, app, plugins) are compared too and logged as needing a
+ * restart rather than silently ignored.
+ *
+ * Config (plugins section of config.json):
+ * - env_file: .env path, relative to the config directory (default ".env")
+ * - interval: seconds between checks (default 2)
+ */
+class ConfigWatcher : public drogon::Plugin<ConfigWatcher>
+{
+  public:
+    ConfigWatcher() = default;
+
+    void initAndStart(const Json::Value &config) override;
+    void shutdown() override;
+
+  private:
+    struct FileStamp
+    {
+        std::filesystem::file_time_type mtime{};
+        uintmax_t size{0};
+        bool exists{false};
+
+        bool operator==(const FileStamp &other) const
+        {
+            return exists == other.exists && mtime == other.mtime && size == other.size;
+        }
+    };
+
+    static FileStamp stamp(const std::string &path);
+    void check();
+    bool reload();
+
+    std::string configPath_;
+    std::string envPath_;
+    FileStamp configStamp_;
+    FileStamp envStamp_;
+    Json::Value startupConfig_;
+    trantor::EventLoop *loop_{nullptr};
+    trantor::TimerId timer_{0};
+};
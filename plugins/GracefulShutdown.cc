@@ -0,0 +1,131 @@
+/**
+ *
+ *  GracefulShutdown.cc
+ *
+ */
+
+#include "GracefulShutdown.h"
+#include "WsConnectionRegistry.h"
+#include "utils/DbStats.h"
+#include "utils/Startup.h"
+#include <drogon/HttpAppFramework.h>
+#include <trantor/utils/Logger.h>
+#include <functional>
+#include <thread>
+
+using namespace drogon;
+
+namespace
+{
+// Set from the signal handler, so nothing but a lock-free store happens there
+std::atomic<bool> termRequested{false};
+std::atomic<bool> draining{false};
+
+// Requests usually finish on another thread than the one they started on,
+// so the counter is split into slots picked by thread and summed (signed)
+// on read; no single cache line is shared by every IO thread.
+constexpr size_t kSlots = 16;
+struct alignas(64) Slot
+{
+    std::atomic<int64_t> value{0};
+};
+Slot slots[kSlots];
+
+Slot &threadSlot()
+{
+    thread_local Slot &slot =
+        slots[std::hash<std::thread::id>{}(std::this_thread::get_id()) % kSlots];
+    return slot;
+}
+}  // namespace
+
+void GracefulShutdown::initAndStart(const Json::Value &config)
+{
+    drainTimeout_ = config.get("drain_timeout", 15.0).asDouble();
+    wsCloseTimeout_ = config.get("ws_close_timeout", 2.0).asDouble();
+
+    app().registerPreRoutingAdvice([](const HttpRequestPtr &) {
+        threadSlot().value.fetch_add(1, std::memory_order_relaxed);
+    });
+    app().registerPreSendingAdvice([](const HttpRequestPtr &, const HttpResponsePtr &resp) {
+        threadSlot().value.fetch_sub(1, std::memory_order_relaxed);
+        if (draining.load(std::memory_order_relaxed))
+            resp->setCloseConnection(true);
+    });
+
+    // drogon calls this from the signal handler itself
+    app().setTermSignalHandler([]() { termRequested.store(true); });
+
+    loop_ = app().getLoop();
+    signalTimer_ = loop_->runEvery(0.1, [this]() {
+        if (termRequested.load() && !draining.load())
+            startDrain();
+    });
+    LOG_INFO << "GracefulShutdown armed, drain timeout " << drainTimeout_ << "s";
+}
+
+void GracefulShutdown::shutdown()
+{
+    if (signalTimer_)
+        loop_->invalidateTimer(signalTimer_);
+    if (drainTimer_)
+        loop_->invalidateTimer(drainTimer_);
+}
+
+int64_t GracefulShutdown::httpInFlight()
+{
+    int64_t total = 0;
+    for (auto &slot : slots)
+        total += slot.value.load(std::memory_order_relaxed);
+    return total;
+}
+
+void GracefulShutdown::startDrain()
+{
+    draining = true;
+    Startup::setDraining();
+    drainStartUs_ = DbStats::nowUs();
+    LOG_WARN << "SIGTERM received, draining " << httpInFlight() << " requests (timeout "
+             << drainTimeout_ << "s)";
+
+    if (auto *registry = app().getPlugin<WsConnectionRegistry>())
+        registry->closeAll(CloseCode::kEndpointGone, "server shutting down");
+
+    loop_->invalidateTimer(signalTimer_);
+    signalTimer_ = 0;
+    drainTimer_ = loop_->runEvery(0.05, [this]() { checkDrained(); });
+}
+
+void GracefulShutdown::checkDrained()
+{
+    auto elapsed = (DbStats::nowUs() - drainStartUs_) / 1e6;
+    auto http = httpInFlight();
+    int64_t db = 0;
+    for (auto *client : DbStats::clients())
+        db += client->inFlight.load(std::memory_order_relaxed);
+    auto *registry = app().getPlugin<WsConnectionRegistry>();
+    size_t ws = registry ? registry->connectionCount() : 0;
+
+    if (ws > 0 && !wsForced_ && elapsed >= wsCloseTimeout_)
+    {
+        LOG_WARN << "Dropping " << ws << " WebSockets that did not answer the close frame";
+        registry->forceCloseAll();
+        wsForced_ = true;
+    }
+
+    if (http > 0 || db > 0 || ws > 0)
+    {
+        if (elapsed < drainTimeout_)
+            return;
+        LOG_WARN << "Drain timed out after " << elapsed << "s with " << http
+                 << " requests, " << db << " queries and " << ws << " WebSockets in flight";
+    }
+    else
+    {
+        LOG_INFO << "Drained in " << elapsed * 1000 << " ms";
+    }
+
+    loop_->invalidateTimer(drainTimer_);
+    drainTimer_ = 0;
+    app().quit();
+}
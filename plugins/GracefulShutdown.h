@@ -0,0 +1,57 @@
+/**
+ *
+ *  GracefulShutdown.h
+ *
+ */
+
+#pragma once
+
+#include <drogon/plugins/Plugin.h>
+#include <trantor/net/EventLoop.h>
+#include <atomic>
+#include <cstdint>
+
+/**
+ * @brief Drains the server on SIGTERM instead of stopping mid-request
+ *
+ * On SIGTERM the process stops reporting ready (/health/ready turns 503),
+ * answers every further response with "Connection: close" so keep-alive
+ * clients reconnect elsewhere, and sends a 1001 close frame to every
+ * WebSocket. It then waits until no HTTP request, database query or
+ * WebSocket is in flight, or until drain_timeout, and only then calls
+ * app().quit(), which runs the other plugins' shutdown() (trace flush,
+ * timers). WebSockets that ignore the close frame are dropped after
+ * ws_close_timeout.
+ *
+ * With "reuse_port": true in the app section, a new process can bind the
+ * same port while this one drains: start it, wait for its /health/ready,
+ * then send SIGTERM here.
+ *
+ * Config (plugins section of config.json):
+ * - drain_timeout: seconds to wait for in-flight work (default 15)
+ * - ws_close_timeout: seconds before unanswered WebSockets are dropped
+ *   (default 2)
+ */
+class GracefulShutdown : public drogon::Plugin<GracefulShutdown>
+{
+  public:
+    GracefulShutdown() = default;
+
+    void initAndStart(const Json::Value &config) override;
+    void shutdown() override;
+
+    /// Requests between routing and response send
+    static int64_t httpInFlight();
+
+  private:
+    void startDrain();
+    void checkDrained();
+
+    double drainTimeout_{15};
+    double wsCloseTimeout_{2};
+    trantor::EventLoop *loop_{nullptr};
+    trantor::TimerId signalTimer_{0};
+    trantor::TimerId drainTimer_{0};
+    int64_t drainStartUs_{0};
+    bool wsForced_{false};
+};
@@ -0,0 +1,139 @@
+/**
+ *
+ *  HistoryPurger.cc
+ *
+ */
+
+#include "HistoryPurger.h"
+#include "utils/DbStats.h"
+#include <drogon/HttpAppFramework.h>
+#include <trantor/utils/Logger.h>
+#include <algorithm>
+
+using namespace drogon;
+using namespace drogon::orm;
+
+void HistoryPurger::initAndStart(const Json::Value &config)
+{
+    interval_ = config.get("interval", 1.0).asDouble();
+    // Each row of a chunk is one bound parameter of the DELETE
+    chunkSize_ = std::clamp<size_t>(config.get("chunk_size", 500).asUInt64(), 1, kMaxChunkSize);
+
+    loop_ = app().getLoop();
+    timer_ = loop_->runEvery(interval_, [this]() { tick(); });
+    LOG_INFO << "HistoryPurger deleting up to " << chunkSize_ << " history rows every "
+             << interval_ << "s";
+}
+
+void HistoryPurger::shutdown()
+{
+    if (timer_)
+        loop_->invalidateTimer(timer_);
+}
+
+HistoryPurger::Stats HistoryPurger::stats() const
+{
+    return {pendingNodes_.load(std::memory_order_relaxed),
+            rowsDeleted_.load(std::memory_order_relaxed),
+            chunks_.load(std::memory_order_relaxed),
+            nodesCompleted_.load(std::memory_order_relaxed)};
+}
+
+void HistoryPurger::tick()
+{
+    if (busy_.exchange(true))
+        return;
+    auto client = app().getDbClient();
+    auto query = DbStats::start("cultural_node_tombstones", "find_oldest", Tracing::Span());
+    client->execSqlAsync(
+        "select node_id, (select count(*) from cultural_node_tombstones) as pending "
+        "from cultural_node_tombstones order by deleted_at limit 1",
+        [this, client, query](const Result &result) {
+            query.done(true);
+            if (result.empty())
+            {
+                pendingNodes_ = 0;
+                busy_ = false;
+                return;
+            }
+            pendingNodes_ = result[0]["pending"].as<uint64_t>();
+            purgeChunk(client, result[0]["node_id"].as<int32_t>());
+        },
+        [this, query](const DrogonDbException &e) {
+            query.done(false);
+            LOG_ERROR << "HistoryPurger: " << e.base().what();
+            busy_ = false;
+        });
+}
+
+void HistoryPurger::purgeChunk(const DbClientPtr &client, int32_t nodeId)
+{
+    // Select then delete by id: LIMIT on DELETE (or in an IN subquery) is
+    // not portable between MySQL and SQLite
+    auto query = DbStats::start("professional_history", "find_purge_chunk", Tracing::Span());
+    client->execSqlAsync(
+        "select id from professional_history where node_id = ? limit " +
+            std::to_string(chunkSize_),
+        [this, client, query, nodeId](const Result &result) {
+            query.done(true);
+            if (result.empty())
+            {
+                dropTombstone(client, nodeId);
+                return;
+            }
+            auto last = result.size() < chunkSize_;
+            std::string sql = "delete from professional_history where id in (";
+            for (size_t i = 0; i < result.size(); ++i)
+                sql += i == 0 ? "?" : ",?";
+            sql += ")";
+
+            auto purge = DbStats::start("professional_history", "purge", Tracing::Span());
+            auto binder = *client << std::move(sql);
+            for (const auto &row : result)
+                binder << row["id"].as<int32_t>();
+            binder >> [this, client, purge, nodeId, last](const Result &deleted)
+                   {
+                       purge.done(true);
+                       rowsDeleted_ += deleted.affectedRows();
+                       ++chunks_;
+                       // A short chunk was the rest of the history
+                       if (last)
+                           dropTombstone(client, nodeId);
+                       else
+                           busy_ = false;
+                   }
+                   >> [this, purge](const DrogonDbException &e)
+                   {
+                       purge.done(false);
+                       LOG_ERROR << "HistoryPurger: " << e.base().what();
+                       busy_ = false;
+                   };
+        },
+        [this, query](const DrogonDbException &e) {
+            query.done(false);
+            LOG_ERROR << "HistoryPurger: " << e.base().what();
+            busy_ = false;
+        },
+        nodeId);
+}
+
+void HistoryPurger::dropTombstone(const DbClientPtr &client, int32_t nodeId)
+{
+    auto query = DbStats::start("cultural_node_tombstones", "delete", Tracing::Span());
+    client->execSqlAsync(
+        "delete from cultural_node_tombstones where node_id = ?",
+        [this, query, nodeId](const Result &) {
+            query.done(true);
+            ++nodesCompleted_;
+            if (pendingNodes_ > 0)
+                --pendingNodes_;
+            LOG_DEBUG << "HistoryPurger: history of node " << nodeId << " removed";
+            busy_ = false;
+        },
+        [this, query](const DrogonDbException &e) {
+            query.done(false);
+            LOG_ERROR << "HistoryPurger: " << e.base().what();
+            busy_ = false;
+        },
+        nodeId);
+}
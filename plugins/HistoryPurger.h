@@ -0,0 +1,68 @@
+/**
+ *
+ *  HistoryPurger.h
+ *
+ */
+
+#pragma once
+
+#include <drogon/plugins/Plugin.h>
+#include <drogon/orm/DbClient.h>
+#include <trantor/net/EventLoop.h>
+#include <atomic>
+#include <cstdint>
+
+/**
+ * @brief Removes the history of deleted nodes in small background chunks
+ *
+ * Deleting a node only removes its row and records a tombstone
+ * (cultural_node_tombstones) in the same transaction, so the request never
+ * waits on, or locks, the node's professional_history rows. This plugin
+ * then works through the tombstones oldest first, deleting at most
+ * chunk_size history rows per tick by primary key; a tombstone is dropped
+ * once its node has no history left. One chunk per tick bounds the load to
+ * chunk_size / interval rows per second, and the tombstone table makes the
+ * work survive a restart.
+ *
+ * Config (plugins section of config.json):
+ * - interval: seconds between chunks (default 1)
+ * - chunk_size: history rows deleted per chunk (default 500, at most 999:
+ *   rows are deleted by id with one bound parameter each, and SQLite
+ *   allows 999 per statement by default)
+ */
+class HistoryPurger : public drogon::Plugin<HistoryPurger>
+{
+  public:
+    struct Stats
+    {
+        uint64_t pendingNodes{0};
+        uint64_t rowsDeleted{0};
+        uint64_t chunks{0};
+        uint64_t nodesCompleted{0};
+    };
+
+    HistoryPurger() = default;
+
+    void initAndStart(const Json::Value &config) override;
+    void shutdown() override;
+
+    Stats stats() const;
+
+  private:
+    static constexpr size_t kMaxChunkSize = 999;
+
+    void tick();
+    void purgeChunk(const drogon::orm::DbClientPtr &client, int32_t nodeId);
+    void dropTombstone(const drogon::orm::DbClientPtr &client, int32_t nodeId);
+
+    double interval_{1};
+    size_t chunkSize_{500};
+    trantor::EventLoop *loop_{nullptr};
+    trantor::TimerId timer_{0};
+    // A chunk can outlast a tick; ticks are skipped until it finishes
+    std::atomic<bool> busy_{false};
+    std::atomic<uint64_t> pendingNodes_{0};
+    std::atomic<uint64_t> rowsDeleted_{0};
+    std::atomic<uint64_t> chunks_{0};
+    std::atomic<uint64_t> nodesCompleted_{0};
+};
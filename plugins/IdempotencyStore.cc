@@ -0,0 +1,291 @@
+/**
+ *
+ *  IdempotencyStore.cc
+ *
+ */
+
+#include "IdempotencyStore.h"
+#include "utils/Metrics.h"
+#include <drogon/HttpAppFramework.h>
+#include <drogon/utils/Utilities.h>
+#include <trantor/utils/Date.h>
+#include <trantor/utils/Logger.h>
+#include <sstream>
+#include <unordered_map>
+
+using namespace drogon;
+
+namespace
+{
+constexpr size_t kMaxKeyLength = 255;
+
+int64_t nowUs()
+{
+    return trantor::Date::now().microSecondsSinceEpoch();
+}
+
+bool validKey(const std::string &key)
+{
+    if (key.size() > kMaxKeyLength)
+        return false;
+    for (auto c : key)
+    {
+        if (static_cast<unsigned char>(c) < 0x20 || c == 0x7f)
+            return false;
+    }
+    return true;
+}
+
+// The latest unexpired record of every key, in log order. Records are
+// "P\t<expires us>\t<status>\t<content type>\t<fingerprint>\t<key>\t<body>".
+std::vector<std::string> liveRecords(std::vector<std::string> records, int64_t nowUs)
+{
+    std::unordered_map<std::string, size_t> latest;
+    std::vector<bool> keep(records.size(), false);
+    for (size_t i = 0; i < records.size(); ++i)
+    {
+        std::istringstream in(records[i]);
+        std::string op, expires, skip, key;
+        std::getline(in, op, '\t');
+        std::getline(in, expires, '\t');
+        for (int field = 0; field < 3; ++field)
+            std::getline(in, skip, '\t');
+        std::getline(in, key, '\t');
+        if (op != "P" || !in)
+            continue;
+        int64_t expiresUs;
+        try
+        {
+            expiresUs = std::stoll(expires);
+        }
+        catch (const std::exception &)
+        {
+            continue;
+        }
+        auto [it, inserted] = latest.try_emplace(key, i);
+        if (!inserted)
+        {
+            keep[it->second] = false;
+            it->second = i;
+        }
+        keep[i] = expiresUs > nowUs;
+    }
+
+    std::vector<std::string> live;
+    for (size_t i = 0; i < records.size(); ++i)
+    {
+        if (keep[i])
+            live.push_back(std::move(records[i]));
+    }
+    return live;
+}
+}  // namespace
+
+void IdempotencyStore::initAndStart(const Json::Value &config)
+{
+    ttl_ = config.get("ttl", 86400).asInt64();
+    auto maxEntries = config.get("max_entries", 100000).asUInt64();
+    responses_ = std::make_unique<TtlCache<std::string, StoredResponse>>(maxEntries);
+
+    auto persistFile = config.get("persist_file", "").asString();
+    if (!persistFile.empty())
+    {
+        if (log_.open(persistFile))
+            restore();
+        else
+            LOG_ERROR << "IdempotencyStore: cannot open " << persistFile
+                      << ", keys will not survive a restart";
+    }
+    if (log_.isOpen())
+    {
+        loop_ = app().getLoop();
+        compactTimer_ = loop_->runEvery(config.get("compact_interval", 3600).asDouble(),
+                                        [this]() { compact(); });
+    }
+
+    LOG_INFO << "IdempotencyStore started, ttl " << ttl_ << "s, up to " << maxEntries
+             << " responses";
+}
+
+void IdempotencyStore::shutdown()
+{
+    // responses_ stays: creates still in flight after the drain reach
+    // remember() from their DB callbacks
+    stopped_ = true;
+    if (compactTimer_)
+        loop_->invalidateTimer(compactTimer_);
+}
+
+void IdempotencyStore::handle(const HttpRequestPtr &req, Callback &&callback, Handler handler)
+{
+    const auto &header = req->getHeader("Idempotency-Key");
+    if (header.empty() || stopped_.load(std::memory_order_relaxed))
+    {
+        handler(std::move(callback));
+        return;
+    }
+    if (!validKey(header))
+    {
+        Json::Value errBody;
+        errBody["error"] = "Idempotency-Key must be at most 255 printable characters";
+        auto resp = HttpResponse::newHttpJsonResponse(errBody);
+        resp->setStatusCode(k400BadRequest);
+        callback(resp);
+        return;
+    }
+
+    // One user's key never answers another user's request
+    std::string user;
+    if (req->attributes()->find("auth.sub"))
+        user = req->attributes()->get<std::string>("auth.sub");
+    auto key = user + '\n' + req->path() + '\n' + header;
+    auto fingerprint = utils::getSha256(std::string(req->getBody()));
+
+    if (auto stored = responses_->get(key, nowUs()))
+    {
+        Metrics::coalescedRequests().inc({"idempotent_replay"});
+        respond(stored, fingerprint, true, callback);
+        return;
+    }
+
+    auto isLeader = std::make_shared<bool>(false);
+    auto leader = flights_.run(
+        key,
+        [callback = std::move(callback), fingerprint, isLeader](const StoredPtr &stored) {
+            respond(stored, fingerprint, !*isLeader, callback);
+        },
+        [this, key, fingerprint, isLeader, handler = std::move(handler)](
+            SingleFlight<StoredPtr>::Finish finish) {
+            *isLeader = true;
+            // The previous flight for this key may have ended since the lookup
+            if (auto stored = responses_->get(key, nowUs()))
+            {
+                *isLeader = false;
+                finish(stored);
+                return;
+            }
+            handler([this, key, fingerprint, finish](const HttpResponsePtr &resp) {
+                auto stored = std::make_shared<const StoredResponse>(
+                    StoredResponse{resp->statusCode(),
+                                   resp->contentType(),
+                                   std::string(resp->getBody()),
+                                   fingerprint});
+                if (stored->status < 500)
+                    remember(key, stored);
+                finish(stored);
+            });
+        });
+    if (!leader)
+        Metrics::coalescedRequests().inc({"idempotent_wait"});
+}
+
+void IdempotencyStore::respond(const StoredPtr &stored,
+                               const std::string &fingerprint,
+                               bool replayed,
+                               const Callback &callback)
+{
+    if (stored->fingerprint != fingerprint)
+    {
+        Json::Value errBody;
+        errBody["error"] = "Idempotency-Key was already used with a different request body";
+        auto resp = HttpResponse::newHttpJsonResponse(errBody);
+        resp->setStatusCode(k422UnprocessableEntity);
+        callback(resp);
+        return;
+    }
+    auto resp = HttpResponse::newHttpResponse();
+    resp->setStatusCode(stored->status);
+    resp->setContentTypeCode(stored->contentType);
+    resp->setBody(stored->body);
+    if (replayed)
+        resp->addHeader("Idempotent-Replayed", "true");
+    callback(resp);
+}
+
+void IdempotencyStore::remember(const std::string &key, const StoredPtr &stored)
+{
+    if (stopped_.load(std::memory_order_relaxed))
+        return;
+    auto now = nowUs();
+    auto ttlUs = ttl_ * 1000000;
+    responses_->put(key, stored, now, now, ttlUs);
+    if (log_.isOpen() && log_.append(record(now + ttlUs, key, *stored)))
+        appended_.fetch_add(1, std::memory_order_relaxed);
+}
+
+// P <expires us> <status> <content type> <fingerprint> <key> <body>, with
+// key and body base64 so neither can break the line format
+std::string IdempotencyStore::record(int64_t expiresUs,
+                                     const std::string &key,
+                                     const StoredResponse &stored)
+{
+    return "P\t" + std::to_string(expiresUs) + "\t" +
+           std::to_string(static_cast<int>(stored.status)) + "\t" +
+           std::to_string(static_cast<int>(stored.contentType)) + "\t" + stored.fingerprint +
+           "\t" + utils::base64Encode(key) + "\t" + utils::base64Encode(stored.body);
+}
+
+void IdempotencyStore::restore()
+{
+    // Keep only what is still replayable so the log does not grow across restarts
+    auto now = nowUs();
+    std::vector<std::string> records;
+    log_.rewrite([&records, now](std::vector<std::string> all) {
+        records = liveRecords(std::move(all), now);
+        return records;
+    });
+
+    size_t restored = 0;
+    for (const auto &line : records)
+    {
+        std::istringstream in(line);
+        std::string op, expires, status, contentType, fingerprint, key, body;
+        std::getline(in, op, '\t');
+        std::getline(in, expires, '\t');
+        std::getline(in, status, '\t');
+        std::getline(in, contentType, '\t');
+        std::getline(in, fingerprint, '\t');
+        std::getline(in, key, '\t');
+        std::getline(in, body);
+        try
+        {
+            auto expiresUs = std::stoll(expires);
+            responses_->put(utils::base64Decode(key),
+                            std::make_shared<const StoredResponse>(StoredResponse{
+                                static_cast<HttpStatusCode>(std::stoi(status)),
+                                static_cast<ContentType>(std::stoi(contentType)),
+                                utils::base64Decode(body),
+                                fingerprint}),
+                            now,
+                            now,
+                            expiresUs - now);
+            ++restored;
+        }
+        catch (const std::exception &)
+        {
+        }
+    }
+
+    LOG_INFO << "IdempotencyStore restored " << restored << " responses";
+}
+
+// Drop expired and superseded records so the file stays proportional to
+// the keys still replayable, however long the process runs
+void IdempotencyStore::compact()
+{
+    if (appended_.exchange(0, std::memory_order_relaxed) == 0)
+        return;
+    size_t before = 0, after = 0;
+    auto now = nowUs();
+    if (!log_.rewrite([&before, &after, now](std::vector<std::string> all) {
+            before = all.size();
+            auto live = liveRecords(std::move(all), now);
+            after = live.size();
+            return live;
+        }))
+    {
+        LOG_ERROR << "IdempotencyStore: compacting the persist file failed";
+        return;
+    }
+    LOG_DEBUG << "IdempotencyStore compacted " << before << " records to " << after;
+}
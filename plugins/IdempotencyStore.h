@@ -0,0 +1,88 @@
+/**
+ *
+ *  IdempotencyStore.h
+ *
+ */
+
+#pragma once
+
+#include <drogon/plugins/Plugin.h>
+#include <drogon/HttpRequest.h>
+#include <drogon/HttpResponse.h>
+#include "utils/AppendOnlyLog.h"
+#include "utils/SingleFlight.h"
+#include "utils/TtlCache.h"
+#include <trantor/net/EventLoop.h>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <string>
+
+/**
+ * @brief Idempotency-Key handling for non-idempotent requests (POST)
+ *
+ * The first request with a given key runs the handler; its response is
+ * kept in memory, so a retry with the same key gets the same status and
+ * body bytes back without running the handler (or touching the database)
+ * again. A duplicate that arrives while the first is still running waits
+ * for it instead of starting a second one. Keys are scoped to the
+ * authenticated user, and reusing one with a different body is rejected
+ * with 422. Server errors (5xx) are not remembered, so they can be retried.
+ *
+ * Config (plugins section of config.json):
+ * - ttl: how long a response is replayed, in seconds (default 86400)
+ * - max_entries: bound on remembered responses (default 100000)
+ * - persist_file: optional append-only file replayed on startup so keys
+ *   survive a restart (default "", disabled)
+ * - compact_interval: how often the persist file is rewritten without its
+ *   expired and superseded records, in seconds (default 3600)
+ */
+class IdempotencyStore : public drogon::Plugin<IdempotencyStore>
+{
+  public:
+    using Callback = std::function<void(const drogon::HttpResponsePtr &)>;
+    using Handler = std::function<void(Callback)>;
+
+    IdempotencyStore() = default;
+
+    void initAndStart(const Json::Value &config) override;
+    void shutdown() override;
+
+    /**
+     * Answer @p req: with the remembered response if its Idempotency-Key
+     * was seen, else by running @p handler once for all concurrent
+     * duplicates. Requests without the header go straight to @p handler.
+     */
+    void handle(const drogon::HttpRequestPtr &req, Callback &&callback, Handler handler);
+
+  private:
+    struct StoredResponse
+    {
+        drogon::HttpStatusCode status;
+        drogon::ContentType contentType;
+        std::string body;
+        std::string fingerprint;  // SHA-256 of the request body
+    };
+    using StoredPtr = std::shared_ptr<const StoredResponse>;
+
+    void remember(const std::string &key, const StoredPtr &stored);
+    static std::string record(int64_t expiresUs,
+                              const std::string &key,
+                              const StoredResponse &stored);
+    void restore();
+    void compact();
+    static void respond(const StoredPtr &stored,
+                        const std::string &fingerprint,
+                        bool replayed,
+                        const Callback &callback);
+
+    std::unique_ptr<TtlCache<std::string, StoredResponse>> responses_;
+    SingleFlight<StoredPtr> flights_;
+    int64_t ttl_{86400};
+    AppendOnlyLog log_;
+    std::atomic<size_t> appended_{0};  // records written since the last compaction
+    trantor::EventLoop *loop_{nullptr};
+    trantor::TimerId compactTimer_{0};
+    // Set by shutdown(); handle() then runs handlers without replay
+    std::atomic<bool> stopped_{false};
+};
@@ -0,0 +1,104 @@
+/**
+ *
+ *  MetricsExporter.cc
+ *
+ */
+
+#include "MetricsExporter.h"
+#include "HistoryPurger.h"
+#include "WsConnectionRegistry.h"
+#include "utils/Metrics.h"
+#include <drogon/HttpAppFramework.h>
+#include <trantor/utils/Date.h>
+#include <trantor/utils/Logger.h>
+
+using namespace drogon;
+
+namespace
+{
+WsConnectionRegistry::Stats wsStats()
+{
+    auto *registry = app().getPlugin<WsConnectionRegistry>();
+    return registry ? registry->stats() : WsConnectionRegistry::Stats{};
+}
+
+HistoryPurger::Stats purgeStats()
+{
+    auto *purger = app().getPlugin<HistoryPurger>();
+    return purger ? purger->stats() : HistoryPurger::Stats{};
+}
+}  // namespace
+
+void MetricsExporter::initAndStart(const Json::Value &config)
+{
+    path_ = config.get("path", "/metrics").asString();
+
+    app().registerPreSendingAdvice([](const HttpRequestPtr &req,
+                                      const HttpResponsePtr &resp) {
+        auto elapsedUs = trantor::Date::now().microSecondsSinceEpoch() -
+                         req->creationDate().microSecondsSinceEpoch();
+        std::string_view route = req->getMatchedPathPattern();
+        if (route.empty())
+            route = "unmatched";
+
+        char status[4];
+        auto code = static_cast<int>(resp->statusCode());
+        status[0] = static_cast<char>('0' + code / 100 % 10);
+        status[1] = static_cast<char>('0' + code / 10 % 10);
+        status[2] = static_cast<char>('0' + code % 10);
+        status[3] = '\0';
+
+        Metrics::httpRequestDuration().observe({req->methodString(), route, status},
+                                               static_cast<double>(elapsedUs) / 1e6);
+    });
+
+    Metrics::addCallback("websocket_connections",
+                         "Open WebSocket connections",
+                         "gauge",
+                         [] { return static_cast<double>(wsStats().active); });
+    Metrics::addCallback("websocket_connections_opened_total",
+                         "WebSocket connections accepted",
+                         "counter",
+                         [] { return static_cast<double>(wsStats().opened); });
+    Metrics::addCallback("websocket_connections_closed_total",
+                         "WebSocket connections closed",
+                         "counter",
+                         [] { return static_cast<double>(wsStats().closed); });
+    Metrics::addCallback("websocket_connections_idle_closed_total",
+                         "WebSocket connections closed by the idle sweep",
+                         "counter",
+                         [] { return static_cast<double>(wsStats().idleClosed); });
+    Metrics::addCallback("history_purge_pending_nodes",
+                         "Deleted nodes whose history is still being removed",
+                         "gauge",
+                         [] { return static_cast<double>(purgeStats().pendingNodes); });
+    Metrics::addCallback("history_purge_rows_deleted_total",
+                         "History rows removed after their node was deleted",
+                         "counter",
+                         [] { return static_cast<double>(purgeStats().rowsDeleted); });
+    Metrics::addCallback("history_purge_chunks_total",
+                         "History delete chunks executed",
+                         "counter",
+                         [] { return static_cast<double>(purgeStats().chunks); });
+    Metrics::addCallback("history_purge_nodes_completed_total",
+                         "Deleted nodes whose history is fully removed",
+                         "counter",
+                         [] { return static_cast<double>(purgeStats().nodesCompleted); });
+
+    app().registerHandler(
+        path_,
+        [](const HttpRequestPtr &,
+           std::function<void(const HttpResponsePtr &)> &&callback) {
+            auto resp = HttpResponse::newHttpResponse();
+            resp->setContentTypeString("text/plain; version=0.0.4; charset=utf-8");
+            resp->setBody(Metrics::render());
+            callback(resp);
+        },
+        {Get});
+
+    LOG_INFO << "MetricsExporter serving " << path_;
+}
+
+void MetricsExporter::shutdown()
+{
+}
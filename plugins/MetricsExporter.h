@@ -0,0 +1,33 @@
+/**
+ *
+ *  MetricsExporter.h
+ *
+ */
+
+#pragma once
+
+#include <drogon/plugins/Plugin.h>
+#include <string>
+
+/**
+ * @brief Serves utils/Metrics in Prometheus text format
+ *
+ * Times every HTTP response from request creation to send and records it
+ * under the matched route pattern (not the raw path, so ids don't blow up
+ * label cardinality). DB query latency comes from DbStats; WebSocket
+ * gauges are sampled from WsConnectionRegistry at scrape time.
+ *
+ * Config (plugins section of config.json):
+ * - path: scrape endpoint (default "/metrics")
+ */
+class MetricsExporter : public drogon::Plugin<MetricsExporter>
+{
+  public:
+    MetricsExporter() = default;
+
+    void initAndStart(const Json::Value &config) override;
+    void shutdown() override;
+
+  private:
+    std::string path_;
+};
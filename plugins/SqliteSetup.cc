@@ -0,0 +1,66 @@
+/**
+ *
+ *  SqliteSetup.cc
+ *
+ */
+
+#include "SqliteSetup.h"
+#include "utils/SqlScript.h"
+#include "utils/Startup.h"
+#include <drogon/HttpAppFramework.h>
+#include <drogon/orm/DbClient.h>
+#include <trantor/utils/Logger.h>
+
+using namespace drogon;
+
+void SqliteSetup::initAndStart(const Json::Value &config)
+{
+    auto name = config.get("client", "default").asString();
+    auto db = app().getDbClient(name);
+    if (!db)
+    {
+        LOG_ERROR << "SqliteSetup: no db client named " << name;
+        return;
+    }
+
+    try
+    {
+        auto journalMode = config.get("journal_mode", "WAL").asString();
+        if (!journalMode.empty())
+        {
+            auto result = db->execSqlSync("PRAGMA journal_mode=" + journalMode);
+            // In-memory databases always report "memory"
+            if (!result.empty())
+                LOG_INFO << "SqliteSetup: journal_mode=" << result[0][0].as<std::string>();
+        }
+
+        // Test the configured value: a resolved "" is the app root, not empty
+        auto schema = config.get("schema", "sql/schema.sqlite.sql").asString();
+        if (!schema.empty())
+        {
+            auto schemaPath = Startup::resolvePath(schema);
+            std::vector<std::string> statements;
+            try
+            {
+                statements = SqlScript::load(schemaPath);
+            }
+            catch (const std::runtime_error &e)
+            {
+                LOG_FATAL << "SqliteSetup: " << e.what();
+                abort();
+            }
+            for (const auto &statement : statements)
+                db->execSqlSync(statement);
+            LOG_INFO << "SqliteSetup: applied " << schemaPath;
+        }
+    }
+    catch (const drogon::orm::DrogonDbException &e)
+    {
+        LOG_FATAL << "SqliteSetup failed: " << e.base().what();
+        abort();
+    }
+}
+
+void SqliteSetup::shutdown()
+{
+}
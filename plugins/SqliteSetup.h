@@ -0,0 +1,33 @@
+/**
+ *
+ *  SqliteSetup.h
+ *
+ */
+
+#pragma once
+
+#include <drogon/plugins/Plugin.h>
+#include <string>
+
+/**
+ * @brief Prepares a SQLite database client before the server takes traffic
+ *
+ * Applies the journal mode and creates the schema synchronously during
+ * startup, so the same CulturalNodes/ProfessionalHistory tables exist on
+ * a fresh file or an in-memory database. WAL is persisted in the database
+ * file, so setting it once covers every pooled connection.
+ *
+ * Config (plugins section of config.json):
+ * - client: db_clients entry to prepare (default "default")
+ * - journal_mode: e.g. "WAL", "" to leave unchanged (default "WAL")
+ * - schema: SQL file run at startup, relative to the config directory, "" to
+ *   skip (default "sql/schema.sqlite.sql")
+ */
+class SqliteSetup : public drogon::Plugin<SqliteSetup>
+{
+  public:
+    SqliteSetup() = default;
+
+    void initAndStart(const Json::Value &config) override;
+    void shutdown() override;
+};
@@ -0,0 +1,215 @@
+/**
+ *
+ *  TokenStore.cc
+ *
+ */
+
+#include "TokenStore.h"
+#include "utils/SecureCompare.h"
+#include <drogon/HttpAppFramework.h>
+#include <drogon/utils/Utilities.h>
+#include <trantor/utils/Date.h>
+#include <trantor/utils/Logger.h>
+#include <sstream>
+#include <unordered_map>
+
+using namespace drogon;
+
+namespace
+{
+constexpr size_t kIdBytes = 8;
+constexpr size_t kSecretBytes = 24;
+
+std::string randomHex(size_t bytes)
+{
+    static const char digits[] = "0123456789abcdef";
+    std::vector<unsigned char> buf(bytes);
+    if (!utils::secureRandomBytes(buf.data(), buf.size()))
+        throw std::runtime_error("secure random source unavailable");
+
+    std::string hex;
+    hex.reserve(bytes * 2);
+    for (auto b : buf)
+    {
+        hex.push_back(digits[b >> 4]);
+        hex.push_back(digits[b & 0x0f]);
+    }
+    return hex;
+}
+
+int64_t nowSeconds()
+{
+    return trantor::Date::now().secondsSinceEpoch();
+}
+
+// Split "<id>.<secret>"; both parts must be non-empty
+bool splitToken(const std::string &token, std::string &id, std::string &secret)
+{
+    auto dot = token.find('.');
+    if (dot == std::string::npos || dot == 0 || dot + 1 == token.size())
+        return false;
+    id = token.substr(0, dot);
+    secret = token.substr(dot + 1);
+    return true;
+}
+}  // namespace
+
+void TokenStore::initAndStart(const Json::Value &config)
+{
+    ttl_ = config.get("ttl", 3600).asUInt64();
+    auto shardNum = std::max<size_t>(1, config.get("shards", 16).asUInt64());
+
+    // Timing wheels tick once a second on the main loop; with 4 wheels of
+    // 200 buckets they cover any realistic TTL.
+    shards_.reserve(shardNum);
+    for (size_t i = 0; i < shardNum; ++i)
+        shards_.push_back(std::make_unique<Shard>(app().getLoop(), 1.0f, 4, 200));
+
+    auto persistFile = config.get("persist_file", "").asString();
+    if (!persistFile.empty())
+    {
+        if (log_.open(persistFile))
+            restore();
+        else
+            LOG_ERROR << "TokenStore: cannot open " << persistFile
+                      << ", tokens will not survive a restart";
+    }
+
+    LOG_INFO << "TokenStore started with " << shards_.size()
+             << " shards, ttl " << ttl_ << "s";
+}
+
+void TokenStore::shutdown()
+{
+    // The shards stay in place: requests still in flight may reach
+    // shardFor(). Their entries are freed with the plugin; from here on
+    // the store answers as if it were empty.
+    stopped_ = true;
+}
+
+TokenStore::Shard &TokenStore::shardFor(const std::string &id)
+{
+    return *shards_[std::hash<std::string>{}(id) % shards_.size()];
+}
+
+void TokenStore::insert(const std::string &id, Entry &&entry)
+{
+    auto remaining = entry.expiresAt - nowSeconds();
+    if (remaining <= 0)
+        return;
+    shardFor(id).insert(id, std::move(entry), static_cast<size_t>(remaining));
+}
+
+std::string TokenStore::issue(const std::string &userId)
+{
+    auto id = randomHex(kIdBytes);
+    auto secret = randomHex(kSecretBytes);
+
+    Entry entry;
+    entry.userId = userId;
+    entry.secretHash = utils::getSha256(secret);
+    entry.expiresAt = nowSeconds() + static_cast<int64_t>(ttl_);
+
+    if (log_.isOpen())
+    {
+        if (userId.find_first_of("\t\n") == std::string::npos)
+            log_.append("I\t" + id + "\t" + entry.secretHash + "\t" +
+                        std::to_string(entry.expiresAt) + "\t" + userId);
+        else
+            LOG_WARN << "TokenStore: user id not persistable, token is memory-only";
+    }
+
+    insert(id, std::move(entry));
+    return id + "." + secret;
+}
+
+bool TokenStore::verify(const std::string &token, const std::string &userId)
+{
+    std::string id, secret;
+    if (!splitToken(token, id, secret))
+        return false;
+
+    if (stopped_.load(std::memory_order_relaxed))
+        return false;
+
+    Entry entry;
+    auto &shard = shardFor(id);
+    if (!shard.findAndFetch(id, entry))
+        return false;
+
+    if (entry.expiresAt <= nowSeconds())
+    {
+        shard.erase(id);
+        return false;
+    }
+
+    // Evaluate both checks unconditionally so timing does not reveal which
+    // one failed.
+    bool secretOk =
+        constantTimeEquals(utils::getSha256(secret), entry.secretHash);
+    bool userOk = entry.userId == userId;
+    return secretOk & userOk;
+}
+
+void TokenStore::revoke(const std::string &token)
+{
+    std::string id, secret;
+    if (!splitToken(token, id, secret))
+        return;
+
+    shardFor(id).erase(id);
+    if (log_.isOpen())
+        log_.append("R\t" + id);
+}
+
+void TokenStore::restore()
+{
+    std::unordered_map<std::string, Entry> live;
+    log_.replay([&live](const std::string &record) {
+        std::istringstream in(record);
+        std::string op, id;
+        std::getline(in, op, '\t');
+        std::getline(in, id, '\t');
+        if (op == "R")
+        {
+            live.erase(id);
+            return;
+        }
+        if (op != "I")
+            return;
+
+        Entry entry;
+        std::string expiresAt;
+        std::getline(in, entry.secretHash, '\t');
+        std::getline(in, expiresAt, '\t');
+        std::getline(in, entry.userId);
+        try
+        {
+            entry.expiresAt = std::stoll(expiresAt);
+        }
+        catch (const std::exception &)
+        {
+            return;
+        }
+        live[id] = std::move(entry);
+    });
+
+    // Rewrite the log with only the tokens that are still valid so it does
+    // not grow without bound across restarts.
+    auto now = nowSeconds();
+    std::vector<std::string> records;
+    size_t restored = 0;
+    for (auto &item : live)
+    {
+        auto &entry = item.second;
+        if (entry.expiresAt <= now)
+            continue;
+        records.push_back("I\t" + item.first + "\t" + entry.secretHash + "\t" +
+                          std::to_string(entry.expiresAt) + "\t" + entry.userId);
+        insert(item.first, std::move(entry));
+        ++restored;
+    }
+    log_.compact(records);
+
+    LOG_INFO << "TokenStore restored " << restored << " tokens";
+}
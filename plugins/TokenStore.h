@@ -0,0 +1,72 @@
+/**
+ *
+ *  TokenStore.h
+ *
+ */
+
+#pragma once
+
+#include <drogon/plugins/Plugin.h>
+#include <drogon/CacheMap.h>
+#include "utils/AppendOnlyLog.h"
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * @brief In-memory store of opaque access tokens issued at login
+ *
+ * Tokens look like "<id>.<secret>". The id selects the shard and entry;
+ * only a SHA-256 of the secret is kept, and it is compared in constant
+ * time. Each shard is a drogon::CacheMap (own mutex, own timing wheel), so
+ * lookups on different shards never contend and expired entries are swept
+ * by the wheel instead of a full scan.
+ *
+ * Config (plugins section of config.json):
+ * - ttl: token lifetime in seconds (default 3600)
+ * - shards: number of shards (default 16)
+ * - persist_file: optional append-only file replayed on startup so issued
+ *   tokens survive a restart (default "", disabled)
+ */
+class TokenStore : public drogon::Plugin<TokenStore>
+{
+  public:
+    TokenStore() = default;
+
+    void initAndStart(const Json::Value &config) override;
+    void shutdown() override;
+
+    /// Issue a new token for @p userId
+    std::string issue(const std::string &userId);
+
+    /// Check that @p token is live and belongs to @p userId
+    bool verify(const std::string &token, const std::string &userId);
+
+    /// Invalidate @p token before its expiry
+    void revoke(const std::string &token);
+
+    size_t ttl() const
+    {
+        return ttl_;
+    }
+
+  private:
+    struct Entry
+    {
+        std::string userId;
+        std::string secretHash;
+        int64_t expiresAt{0};
+    };
+    using Shard = drogon::CacheMap<std::string, Entry>;
+
+    Shard &shardFor(const std::string &id);
+    void insert(const std::string &id, Entry &&entry);
+    void restore();
+
+    std::vector<std::unique_ptr<Shard>> shards_;
+    // Set by shutdown(); verify() then rejects every token
+    std::atomic<bool> stopped_{false};
+    size_t ttl_{3600};
+    AppendOnlyLog log_;
+};
@@ -0,0 +1,108 @@
+/**
+ *
+ *  TraceExporter.cc
+ *
+ */
+
+#include "TraceExporter.h"
+#include <drogon/HttpAppFramework.h>
+#include <trantor/utils/Logger.h>
+
+using namespace drogon;
+
+namespace
+{
+const std::string kSpanKey = "trace.span";
+const std::string kRoutingKey = "trace.routing";
+}  // namespace
+
+void TraceExporter::initAndStart(const Json::Value &config)
+{
+    serviceName_ = config.get("service_name", "culture_hub").asString();
+    Tracing::configure(config.get("sample_ratio", 0.01).asDouble(),
+                       config.get("ring_capacity", 8192).asUInt64());
+
+    auto path = config.get("file", "").asString();
+    if (!path.empty())
+    {
+        file_.open(path, std::ios::app);
+        if (!file_)
+            LOG_ERROR << "TraceExporter: cannot open " << path;
+    }
+    auto collector = config.get("collector", "").asString();
+    if (!collector.empty())
+        collector_ = HttpClient::newHttpClient(collector);
+
+    app().registerPreRoutingAdvice([](const HttpRequestPtr &req) {
+        auto startUs = req->creationDate().microSecondsSinceEpoch();
+        auto root = Tracing::Span::root(req->getHeader("traceparent"), "http.server", startUs);
+        if (!root.sampled())
+            return;
+        req->attributes()->insert(kSpanKey, root);
+        req->attributes()->insert(kRoutingKey, root.child("routing", startUs));
+    });
+
+    app().registerPreHandlingAdvice([](const HttpRequestPtr &req) {
+        if (req->attributes()->find(kRoutingKey))
+            req->attributes()->get<Tracing::Span>(kRoutingKey).end();
+    });
+
+    app().registerPreSendingAdvice([](const HttpRequestPtr &req,
+                                      const HttpResponsePtr &resp) {
+        if (!req->attributes()->find(kSpanKey))
+            return;
+        const auto &root = req->attributes()->get<Tracing::Span>(kSpanKey);
+        auto status = static_cast<int>(resp->statusCode());
+        root.end("http.status_code", status, status >= 500);
+        resp->addHeader("traceresponse", root.traceparent());
+    });
+
+    loop_ = app().getLoop();
+    flushTimer_ = loop_->runEvery(config.get("flush_interval", 1.0).asDouble(),
+                                  [this]() { flush(); });
+
+    LOG_INFO << "TraceExporter started, sample ratio "
+             << config.get("sample_ratio", 0.01).asDouble();
+}
+
+void TraceExporter::shutdown()
+{
+    if (flushTimer_)
+        loop_->invalidateTimer(flushTimer_);
+    flush();
+    if (Tracing::dropped() > 0)
+        LOG_WARN << "TraceExporter dropped " << Tracing::dropped() << " spans";
+}
+
+Tracing::Span TraceExporter::requestSpan(const HttpRequestPtr &req)
+{
+    if (!req->attributes()->find(kSpanKey))
+        return Tracing::Span();
+    return req->attributes()->get<Tracing::Span>(kSpanKey);
+}
+
+void TraceExporter::flush()
+{
+    std::vector<Tracing::SpanRecord> spans;
+    if (Tracing::drain(spans) == 0)
+        return;
+
+    auto body = Tracing::toOtlpJson(spans, serviceName_);
+    if (file_.is_open())
+    {
+        Json::StreamWriterBuilder writer;
+        writer["indentation"] = "";
+        file_ << Json::writeString(writer, body) << '\n';
+        file_.flush();
+    }
+    if (collector_)
+    {
+        auto req = HttpRequest::newHttpJsonRequest(body);
+        req->setMethod(Post);
+        req->setPath("/v1/traces");
+        collector_->sendRequest(req, [](ReqResult result, const HttpResponsePtr &resp) {
+            if (result != ReqResult::Ok || resp->statusCode() >= 300)
+                LOG_WARN << "TraceExporter: collector export failed";
+        });
+    }
+}
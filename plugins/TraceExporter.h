@@ -0,0 +1,53 @@
+/**
+ *
+ *  TraceExporter.h
+ *
+ */
+
+#pragma once
+
+#include <drogon/plugins/Plugin.h>
+#include <drogon/HttpClient.h>
+#include <trantor/net/EventLoop.h>
+#include "utils/Tracing.h"
+#include <fstream>
+#include <string>
+
+/**
+ * @brief Starts a trace per request and exports finished spans as OTLP/JSON
+ *
+ * Each request gets an "http.server" root span (continuing an incoming
+ * W3C traceparent when present) and a "routing" child that ends when the
+ * handler is entered; handlers add their own children through
+ * requestSpan(). Sampled requests get a traceresponse header. Finished
+ * spans sit in the lock-free ring of utils/Tracing until the flush timer
+ * drains them to a JSON-lines file and/or an OTLP/HTTP collector.
+ *
+ * Config (plugins section of config.json):
+ * - sample_ratio: fraction of new traces to record, 0..1 (default 0.01)
+ * - ring_capacity: spans buffered between flushes (default 8192)
+ * - flush_interval: seconds between flushes (default 1)
+ * - file: JSON-lines output, one export request per line (default "")
+ * - collector: OTLP/HTTP base URL, e.g. "http://127.0.0.1:4318" (default "")
+ * - service_name: resource service.name (default "culture_hub")
+ */
+class TraceExporter : public drogon::Plugin<TraceExporter>
+{
+  public:
+    TraceExporter() = default;
+
+    void initAndStart(const Json::Value &config) override;
+    void shutdown() override;
+
+    /// Root span of @p req, or an unsampled span if the request isn't traced
+    static Tracing::Span requestSpan(const drogon::HttpRequestPtr &req);
+
+  private:
+    void flush();
+
+    std::string serviceName_;
+    std::ofstream file_;
+    drogon::HttpClientPtr collector_;
+    trantor::EventLoop *loop_{nullptr};
+    trantor::TimerId flushTimer_{0};
+};
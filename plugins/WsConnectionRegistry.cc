@@ -0,0 +1,216 @@
+/**
+ *
+ *  WsConnectionRegistry.cc
+ *
+ */
+
+#include "WsConnectionRegistry.h"
+#include <drogon/HttpAppFramework.h>
+#include <trantor/utils/Date.h>
+#include <trantor/utils/Logger.h>
+
+using namespace drogon;
+
+void WsConnectionRegistry::initAndStart(const Json::Value &config)
+{
+    idleTimeoutUs_ =
+        static_cast<int64_t>(config.get("idle_timeout", 0).asDouble() * 1000000);
+    double sweepInterval = config.get("sweep_interval", 10).asDouble();
+
+    auto threadNum = app().getThreadNum();
+    shards_.reserve(threadNum);
+    for (size_t i = 0; i < threadNum; ++i)
+    {
+        auto shard = std::make_unique<Shard>();
+        shard->loop = app().getIOLoop(i);
+        shards_.push_back(std::move(shard));
+    }
+
+    if (idleTimeoutUs_ > 0 && sweepInterval > 0)
+    {
+        for (auto &shard : shards_)
+        {
+            auto *s = shard.get();
+            s->idleTimer =
+                s->loop->runEvery(sweepInterval, [this, s]() { sweepIdle(*s); });
+        }
+    }
+
+    LOG_INFO << "WsConnectionRegistry started with " << shards_.size()
+             << " shards, idle timeout " << idleTimeoutUs_ / 1000000 << "s";
+}
+
+void WsConnectionRegistry::shutdown()
+{
+    for (auto &shard : shards_)
+    {
+        if (shard->idleTimer)
+            shard->loop->invalidateTimer(shard->idleTimer);
+    }
+}
+
+WsConnectionRegistry::Shard *WsConnectionRegistry::currentShard() const
+{
+    auto index = app().getCurrentThreadIndex();
+    if (index >= shards_.size())
+    {
+        LOG_ERROR << "WsConnectionRegistry used outside of an IO thread";
+        return nullptr;
+    }
+    return shards_[index].get();
+}
+
+void WsConnectionRegistry::add(const WebSocketConnectionPtr &conn)
+{
+    auto *shard = currentShard();
+    if (!shard)
+        return;
+
+    auto inserted = shard->conns
+                        .emplace(conn.get(),
+                                 Entry{conn,
+                                       trantor::Date::now().microSecondsSinceEpoch()})
+                        .second;
+    if (inserted)
+    {
+        shard->active.fetch_add(1, std::memory_order_relaxed);
+        shard->opened.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+void WsConnectionRegistry::remove(const WebSocketConnectionPtr &conn)
+{
+    auto *shard = currentShard();
+    if (!shard)
+        return;
+
+    if (shard->conns.erase(conn.get()) > 0)
+    {
+        shard->active.fetch_sub(1, std::memory_order_relaxed);
+        shard->closed.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+void WsConnectionRegistry::touch(const WebSocketConnectionPtr &conn)
+{
+    if (idleTimeoutUs_ <= 0)
+        return;
+
+    auto *shard = currentShard();
+    if (!shard)
+        return;
+
+    auto it = shard->conns.find(conn.get());
+    if (it != shard->conns.end())
+        it->second.lastActiveUs = trantor::Date::now().microSecondsSinceEpoch();
+}
+
+void WsConnectionRegistry::broadcast(std::string message,
+                                     WebSocketMessageType type)
+{
+    // Shared so every loop sends the same buffer instead of its own copy
+    auto payload = std::make_shared<const std::string>(std::move(message));
+    for (auto &shard : shards_)
+    {
+        auto *s = shard.get();
+        s->loop->runInLoop([s, payload, type]() {
+            for (auto &item : s->conns)
+            {
+                item.second.conn->send(*payload, type);
+            }
+        });
+    }
+}
+
+void WsConnectionRegistry::closeAll(CloseCode code, const std::string &reason)
+{
+    for (auto &shard : shards_)
+    {
+        auto *s = shard.get();
+        s->loop->runInLoop([s, code, reason]() {
+            // shutdown() may remove the entry synchronously
+            std::vector<WebSocketConnectionPtr> conns;
+            for (auto &item : s->conns)
+            {
+                if (item.second.closing)
+                    continue;
+                item.second.closing = true;
+                conns.push_back(item.second.conn);
+            }
+            for (auto &conn : conns)
+                conn->shutdown(code, reason);
+        });
+    }
+}
+
+void WsConnectionRegistry::forceCloseAll()
+{
+    for (auto &shard : shards_)
+    {
+        auto *s = shard.get();
+        s->loop->runInLoop([s]() {
+            std::vector<WebSocketConnectionPtr> conns;
+            for (auto &item : s->conns)
+                conns.push_back(item.second.conn);
+            for (auto &conn : conns)
+                conn->forceClose();
+        });
+    }
+}
+
+void WsConnectionRegistry::sweepIdle(Shard &shard)
+{
+    auto now = trantor::Date::now().microSecondsSinceEpoch();
+
+    // Closing a connection may run handleConnectionClosed (and so remove())
+    // synchronously, so collect the victims before touching any of them.
+    std::vector<Entry *> idle;
+    for (auto &item : shard.conns)
+    {
+        if (now - item.second.lastActiveUs >= idleTimeoutUs_)
+            idle.push_back(&item.second);
+    }
+
+    std::vector<WebSocketConnectionPtr> toShutdown, toForceClose;
+    for (auto *entry : idle)
+    {
+        // Ask politely first; a peer that never answers the close frame is
+        // dropped on a later sweep.
+        if (!entry->closing)
+        {
+            entry->closing = true;
+            toShutdown.push_back(entry->conn);
+        }
+        else if (now - entry->lastActiveUs >= 2 * idleTimeoutUs_)
+        {
+            toForceClose.push_back(entry->conn);
+        }
+    }
+
+    shard.idleClosed.fetch_add(toShutdown.size(), std::memory_order_relaxed);
+    for (auto &conn : toShutdown)
+        conn->shutdown(CloseCode::kNormalClosure, "idle timeout");
+    for (auto &conn : toForceClose)
+        conn->forceClose();
+}
+
+size_t WsConnectionRegistry::connectionCount() const
+{
+    size_t total = 0;
+    for (auto &shard : shards_)
+        total += shard->active.load(std::memory_order_relaxed);
+    return total;
+}
+
+WsConnectionRegistry::Stats WsConnectionRegistry::stats() const
+{
+    Stats stats;
+    for (auto &shard : shards_)
+    {
+        stats.active += shard->active.load(std::memory_order_relaxed);
+        stats.opened += shard->opened.load(std::memory_order_relaxed);
+        stats.closed += shard->closed.load(std::memory_order_relaxed);
+        stats.idleClosed += shard->idleClosed.load(std::memory_order_relaxed);
+    }
+    return stats;
+}
@@ -0,0 +1,99 @@
+/**
+ *
+ *  WsConnectionRegistry.h
+ *
+ */
+
+#pragma once
+
+#include <drogon/plugins/Plugin.h>
+#include <drogon/WebSocketController.h>
+#include <trantor/net/EventLoop.h>
+#include <atomic>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief Registry of open WebSocket connections, sharded per IO loop
+ *
+ * Every IO thread owns one shard and is the only thread that ever touches
+ * that shard's connection table, so no mutex is needed on the hot path.
+ * Cross-thread operations (broadcast, closeAll) are queued onto the owning
+ * loops; counters are per-shard atomics summed on read.
+ *
+ * Config (plugins section of config.json):
+ * - idle_timeout: seconds without traffic before a connection is closed,
+ *   0 disables the idle sweep (default 0)
+ * - sweep_interval: seconds between idle sweeps (default 10)
+ */
+class WsConnectionRegistry : public drogon::Plugin<WsConnectionRegistry>
+{
+  public:
+    struct Stats
+    {
+        size_t active{0};
+        uint64_t opened{0};
+        uint64_t closed{0};
+        uint64_t idleClosed{0};
+    };
+
+    WsConnectionRegistry() = default;
+
+    void initAndStart(const Json::Value &config) override;
+    void shutdown() override;
+
+    /// Register a connection; must be called on the connection's IO thread
+    void add(const drogon::WebSocketConnectionPtr &conn);
+
+    /// Unregister a connection; must be called on the connection's IO thread
+    void remove(const drogon::WebSocketConnectionPtr &conn);
+
+    /// Mark a connection as active; must be called on the connection's IO thread
+    void touch(const drogon::WebSocketConnectionPtr &conn);
+
+    /// Send a message to every registered connection, each loop sending to
+    /// its own connections. Safe to call from any thread.
+    void broadcast(std::string message,
+                   drogon::WebSocketMessageType type =
+                       drogon::WebSocketMessageType::Text);
+
+    /// Send a close frame to every registered connection. Safe to call
+    /// from any thread.
+    void closeAll(drogon::CloseCode code, const std::string &reason);
+
+    /// Drop every registered connection without waiting for the peer.
+    /// Safe to call from any thread.
+    void forceCloseAll();
+
+    size_t connectionCount() const;
+    Stats stats() const;
+
+  private:
+    struct Entry
+    {
+        drogon::WebSocketConnectionPtr conn;
+        int64_t lastActiveUs;
+        bool closing{false};
+    };
+
+    // One shard per IO loop; aligned so the counters of neighbouring
+    // shards never share a cache line.
+    struct alignas(64) Shard
+    {
+        trantor::EventLoop *loop{nullptr};
+        trantor::TimerId idleTimer{0};
+        std::unordered_map<const drogon::WebSocketConnection *, Entry> conns;
+        std::atomic<size_t> active{0};
+        std::atomic<uint64_t> opened{0};
+        std::atomic<uint64_t> closed{0};
+        std::atomic<uint64_t> idleClosed{0};
+    };
+
+    Shard *currentShard() const;
+    void sweepIdle(Shard &shard);
+
+    std::vector<std::unique_ptr<Shard>> shards_;
+    int64_t idleTimeoutUs_{0};
+};
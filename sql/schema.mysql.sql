@@ -0,0 +1,45 @@
+-- culture_hub schema for MySQL / MariaDB (source of the generated models)
+
+CREATE TABLE IF NOT EXISTS cultural_nodes (
+    id INT AUTO_INCREMENT PRIMARY KEY,
+    name VARCHAR(100) NOT NULL,
+    sort SET('venue','university','collective','cultural hub','residence','artist',
+             'manager','festival','concert series','label','radio','other') NOT NULL,
+    description TEXT,
+    website VARCHAR(100),
+    social JSON,
+    contact JSON,
+    address VARCHAR(50),
+    city VARCHAR(20) NOT NULL,
+    country VARCHAR(50),
+    version INT NOT NULL DEFAULT 1,
+    -- Natural key of PUT /cultural_nodes/by-key; NOT NULL because NULLs never collide
+    UNIQUE KEY cultural_nodes_name_city (name, city)
+);
+
+CREATE TABLE IF NOT EXISTS professional_history (
+    id INT AUTO_INCREMENT PRIMARY KEY,
+    project VARCHAR(50) NOT NULL,
+    node_id INT NOT NULL,
+    sort SET('concert','workshop','conference','exhibitions','residence','other') NOT NULL,
+    event_date DATE NOT NULL,
+    event_description TEXT,
+    fee DECIMAL(5,2),
+    version INT NOT NULL DEFAULT 1,
+    INDEX (node_id)
+);
+
+-- Nodes deleted but whose history is still being removed (HistoryPurger)
+CREATE TABLE IF NOT EXISTS cultural_node_tombstones (
+    node_id INT PRIMARY KEY,
+    deleted_at BIGINT NOT NULL,
+    INDEX (deleted_at)
+);
+
+-- Existing databases, before the version columns:
+-- ALTER TABLE cultural_nodes ADD COLUMN version INT NOT NULL DEFAULT 1;
+-- ALTER TABLE professional_history ADD COLUMN version INT NOT NULL DEFAULT 1;
+-- Before the natural key used by PUT /cultural_nodes/by-key:
+-- ALTER TABLE cultural_nodes MODIFY name VARCHAR(100) NOT NULL, MODIFY city VARCHAR(20) NOT NULL;
+-- ALTER TABLE cultural_nodes ADD UNIQUE KEY cultural_nodes_name_city (name, city);
+-- Before background history purging, create cultural_node_tombstones as above.
@@ -0,0 +1,38 @@
+-- culture_hub schema for SQLite (same columns as schema.mysql.sql)
+
+CREATE TABLE IF NOT EXISTS cultural_nodes (
+    id INTEGER PRIMARY KEY AUTOINCREMENT,
+    name TEXT NOT NULL,
+    sort TEXT NOT NULL,
+    description TEXT,
+    website TEXT,
+    social TEXT,
+    contact TEXT,
+    address TEXT,
+    city TEXT NOT NULL,
+    country TEXT,
+    version INTEGER NOT NULL DEFAULT 1
+);
+
+CREATE TABLE IF NOT EXISTS professional_history (
+    id INTEGER PRIMARY KEY AUTOINCREMENT,
+    project TEXT NOT NULL,
+    node_id INTEGER NOT NULL,
+    sort TEXT NOT NULL,
+    event_date TEXT NOT NULL,
+    event_description TEXT,
+    fee NUMERIC,
+    version INTEGER NOT NULL DEFAULT 1
+);
+
+-- Natural key of PUT /cultural_nodes/by-key; NOT NULL because NULLs never collide
+CREATE UNIQUE INDEX IF NOT EXISTS cultural_nodes_name_city ON cultural_nodes (name, city);
+CREATE INDEX IF NOT EXISTS professional_history_node_id ON professional_history (node_id);
+
+-- Nodes deleted but whose history is still being removed (HistoryPurger)
+CREATE TABLE IF NOT EXISTS cultural_node_tombstones (
+    node_id INTEGER PRIMARY KEY,
+    deleted_at INTEGER NOT NULL
+);
+
+CREATE INDEX IF NOT EXISTS cultural_node_tombstones_deleted_at ON cultural_node_tombstones (deleted_at);
@@ -1,12 +1,291 @@
 #define DROGON_TEST_MAIN
 #include <drogon/drogon_test.h>
 #include <drogon/drogon.h>
+#include "utils/SignedToken.h"
+#include "utils/LatencyHistogram.h"
+#include "utils/Metrics.h"
+#include "utils/Tracing.h"
+#include "utils/RuntimeConfig.h"
+#include "utils/SingleFlight.h"
+#include "utils/BatchLoader.h"
+#include "utils/TtlCache.h"
+#include "utils/OptimisticLock.h"
+#include "utils/BulkTarget.h"
+#include "utils/SqlScript.h"
+#include "utils/WriteCoalescer.h"
+#include <algorithm>
+#include <map>
 
 DROGON_TEST(BasicTest)
 {
     // Add your tests here
 }
 
+DROGON_TEST(SignedTokenTest)
+{
+    Json::Value claims;
+    claims["sub"] = "john_doe";
+    claims["exp"] = Json::Int64(2000);
+    auto token = SignedToken::sign(claims, "secret");
+
+    Json::Value out;
+    std::string err;
+    REQUIRE(SignedToken::verify(token, "secret", 1000, out, err));
+    CHECK(out["sub"].asString() == "john_doe");
+
+    CHECK(!SignedToken::verify(token, "secret", 2000, out, err));
+    CHECK(!SignedToken::verify(token, "wrong-secret", 1000, out, err));
+
+    auto tampered = token;
+    tampered[tampered.size() - 2] ^= 1;
+    CHECK(!SignedToken::verify(tampered, "secret", 1000, out, err));
+
+    // Header pins HS256; anything else is rejected before the HMAC
+    auto noneAlg = SignedToken::base64UrlEncode("{\"alg\":\"none\"}") +
+                   token.substr(token.find('.'));
+    CHECK(!SignedToken::verify(noneAlg, "secret", 1000, out, err));
+}
+
+DROGON_TEST(LatencyHistogramTest)
+{
+    LatencyHistogram hist(60 * 1000000LL);
+    for (int64_t v = 1; v <= 1000; ++v)
+        hist.record(v * 100, 0);
+
+    auto snap = hist.snapshot(0);
+    CHECK(snap.count == 1000);
+    CHECK(snap.max == 100000);
+    // Buckets are ~6% wide
+    CHECK(snap.p50 > 47000);
+    CHECK(snap.p50 < 53000);
+    CHECK(snap.p99 > 93000);
+    CHECK(snap.p99 <= 100000);
+
+    // Samples age out once the whole window has passed
+    CHECK(hist.snapshot(hist.windowUs()).count == 0);
+}
+
+DROGON_TEST(MetricsTest)
+{
+    MetricFamily hist("test_duration_seconds",
+                      "Test histogram",
+                      MetricFamily::Type::Histogram,
+                      {"route"},
+                      {0.1, 1});
+    hist.observe({"/a"}, 0.05);
+    hist.observe({"/a"}, 0.5);
+    hist.observe({"/a"}, 5);
+    std::thread([&hist]() { hist.observe({"/a"}, 0.05); }).join();
+
+    std::string out;
+    hist.render(out);
+    // Shards from both threads are merged; buckets are cumulative
+    CHECK(out.find("test_duration_seconds_bucket{route=\"/a\",le=\"0.1\"} 2\n") !=
+          std::string::npos);
+    CHECK(out.find("test_duration_seconds_bucket{route=\"/a\",le=\"1\"} 3\n") !=
+          std::string::npos);
+    CHECK(out.find("test_duration_seconds_bucket{route=\"/a\",le=\"+Inf\"} 4\n") !=
+          std::string::npos);
+    CHECK(out.find("test_duration_seconds_count{route=\"/a\"} 4\n") != std::string::npos);
+
+    MetricFamily counter("test_total", "Test counter", MetricFamily::Type::Counter, {"v"});
+    counter.inc({"a\"b"}, 3);
+    out.clear();
+    counter.render(out);
+    CHECK(out.find("test_total{v=\"a\\\"b\"} 3\n") != std::string::npos);
+}
+
+DROGON_TEST(TracingTest)
+{
+    uint64_t hi, lo, spanId;
+    bool sampled;
+    REQUIRE(Tracing::parseTraceparent(
+        "00-4bf92f3577b34da6a3ce929d0e0e4736-00f067aa0ba902b7-01", hi, lo, spanId, sampled));
+    CHECK(hi == 0x4bf92f3577b34da6ULL);
+    CHECK(lo == 0xa3ce929d0e0e4736ULL);
+    CHECK(spanId == 0x00f067aa0ba902b7ULL);
+    CHECK(sampled);
+    CHECK(!Tracing::parseTraceparent(
+        "00-00000000000000000000000000000000-00f067aa0ba902b7-01", hi, lo, spanId, sampled));
+    CHECK(!Tracing::parseTraceparent("00-4bf92f35-01", hi, lo, spanId, sampled));
+
+    // The caller's sampling decision and trace id are kept
+    auto root = Tracing::Span::root(
+        "00-4bf92f3577b34da6a3ce929d0e0e4736-00f067aa0ba902b7-00", "test");
+    CHECK(!root.sampled());
+    CHECK(root.traceparent() == "00-4bf92f3577b34da6a3ce929d0e0e4736-00f067aa0ba902b7-00");
+
+    // A server span continuing a sampled trace is still SERVER; its
+    // children are INTERNAL
+    Tracing::configure(0, 8);
+    auto server = Tracing::Span::root(
+        "00-4bf92f3577b34da6a3ce929d0e0e4736-00f067aa0ba902b7-01", "server");
+    REQUIRE(server.sampled());
+    server.child("child").end();
+    server.end();
+    std::vector<Tracing::SpanRecord> spans;
+    REQUIRE(Tracing::drain(spans) == 2);
+    auto otlp = Tracing::toOtlpJson(spans, "test")["resourceSpans"][0]["scopeSpans"][0]["spans"];
+    CHECK(otlp[0]["kind"].asInt() == 1);
+    CHECK(otlp[1]["kind"].asInt() == 2);
+
+    Tracing::SpanRing ring(4);
+    Tracing::SpanRecord record;
+    for (int i = 0; i < 4; ++i)
+    {
+        record.value = i;
+        CHECK(ring.push(record));
+    }
+    CHECK(!ring.push(record));
+    for (int i = 0; i < 4; ++i)
+    {
+        REQUIRE(ring.pop(record));
+        CHECK(record.value == i);
+    }
+    CHECK(!ring.pop(record));
+}
+
+DROGON_TEST(RuntimeConfigTest)
+{
+    Json::Value custom;
+    custom["pagination"]["max_limit"] = 50;
+    custom["pagination"]["default_limit"] = 10;
+    custom["cors"]["allowed_origins"].append("https://app.example.org");
+    custom["db_health"]["cache_ttl_ms"] = 250;
+    std::map<std::string, std::string> dotenv{{"JWT_SECRET", "from-dotenv"},
+                                              {"DB_HEALTH_CACHE_TTL_MS", "750"},
+                                              {"AUTH_USERS", "alice:s1:" + std::string(64, '0')}};
+    std::vector<std::string> errors;
+    auto config = RuntimeConfig::build(custom, dotenv, errors);
+    CHECK(errors.empty());
+    CHECK(config->maxPageSize == 50);
+    CHECK(config->defaultPageSize == 10);
+    CHECK(config->dbHealthCacheTtlMs == 750);  // .env wins over config.json
+    CHECK(config->rateLimitIntervalSec == 10);
+    CHECK(config->jwtSecret == "from-dotenv");
+    CHECK(config->authUsers.size() == 1);
+    CHECK(config->originAllowed("https://app.example.org"));
+    CHECK(!config->originAllowed("https://other.example.org"));
+    CHECK(config->originRejected("http://www.some-evil-place.com"));
+
+    // Wrong types and out-of-range values are reported and keep the default
+    custom["rate_limit"]["min_interval_sec"] = "ten";
+    custom["pagination"]["default_limit"] = 80;
+    dotenv["CORS_REJECTED_ORIGINS"] = "a.example, b.example";
+    dotenv["DB_HEALTH_CACHE_TTL_MS"] = "soon";
+    dotenv["AUTH_USERS"] = "alice:plaintext-password";
+    errors.clear();
+    auto invalid = RuntimeConfig::build(custom, dotenv, errors);
+    CHECK(errors.size() == 4);
+    CHECK(invalid->authUsers.empty());
+    CHECK(invalid->rateLimitIntervalSec == 10);
+    CHECK(invalid->defaultPageSize == 20);
+    CHECK(invalid->dbHealthCacheTtlMs == 1000);
+    CHECK(invalid->corsRejectedOrigins.size() == 2);
+    CHECK(invalid->originRejected("https://b.example"));
+
+    // A thread keeps its snapshot alive until it looks again
+    const auto &before = RuntimeConfig::current();
+    auto held = RuntimeConfig::snapshot();
+    auto version = RuntimeConfig::publish(config);
+    CHECK(version > held->version);
+    CHECK(before.version == held->version);
+    CHECK(RuntimeConfig::current().version == version);
+    CHECK(RuntimeConfig::current().maxPageSize == 50);
+}
+
+DROGON_TEST(SingleFlightTest)
+{
+    SingleFlight<int> flights;
+    SingleFlight<int>::Finish pending;
+    int runs = 0;
+    std::vector<int> results;
+    auto work = [&](SingleFlight<int>::Finish finish) {
+        ++runs;
+        pending = std::move(finish);
+    };
+    auto collect = [&](const int &value) { results.push_back(value); };
+
+    CHECK(flights.run("a", collect, work));
+    CHECK(!flights.run("a", collect, work));
+    CHECK(flights.run("b", collect, [](auto finish) { finish(7); }));
+    CHECK(results == std::vector<int>{7});
+    pending(42);
+    CHECK(runs == 1);
+    CHECK(results == (std::vector<int>{7, 42, 42}));
+
+    // Finished keys are not cached
+    CHECK(flights.run("a", collect, work));
+    CHECK(runs == 2);
+    pending(1);
+
+    // A newer generation never joins an older flight; both finish on their own
+    results.clear();
+    SingleFlight<int>::Finish older;
+    CHECK(flights.run("c", collect, [&](auto finish) { older = std::move(finish); }, 1));
+    CHECK(flights.run("c", collect, work, 2));
+    CHECK(!flights.run("c", collect, work, 2));
+    CHECK(!flights.run("c", collect, work, 1));
+    older(5);
+    CHECK(results == std::vector<int>{5});
+    pending(6);
+    CHECK(results == (std::vector<int>{5, 6, 6, 6}));
+    CHECK(flights.run("c", collect, [](auto finish) { finish(0); }, 2));
+}
+
+DROGON_TEST(BatchLoaderTest)
+{
+    using Loader = BatchLoader<int, std::string>;
+    std::vector<size_t> fetches;
+    Loader loader([&fetches](std::vector<int> keys, Loader::Done done) {
+        fetches.push_back(keys.size());
+        std::unordered_map<int, std::string> found;
+        for (auto key : keys)
+            if (key != 3)
+                found.emplace(key, std::to_string(key));
+        done(true, std::move(found));
+    });
+
+    // Everything loaded in one loop iteration goes out as one fetch
+    std::promise<std::vector<std::string>> results;
+    drogon::app().getLoop()->queueInLoop([&loader, &results]() {
+        auto out = std::make_shared<std::vector<std::string>>();
+        auto collect = [out, &results](const std::string *value, bool failed) {
+            out->push_back(failed ? "failed" : value ? *value : "missing");
+            if (out->size() == 4)
+                results.set_value(*out);
+        };
+        Loader::Options options{0, 100};
+        for (int key : {1, 2, 1, 3})
+            loader.load(key, collect, options);
+    });
+    auto values = results.get_future().get();
+    std::sort(values.begin(), values.end());
+    CHECK(fetches == std::vector<size_t>{3});
+    CHECK(values == (std::vector<std::string>{"1", "1", "2", "missing"}));
+}
+
+DROGON_TEST(TtlCacheTest)
+{
+    TtlCache<int, std::string> cache(64);
+    auto value = std::make_shared<const std::string>("v1");
+    cache.put(1, value, 100, 100, 50);
+    CHECK(cache.get(1, 120) == value);
+    CHECK(cache.get(1, 150) == nullptr);  // expired
+    CHECK(cache.get(2, 120) == nullptr);
+
+    // A fetch that started before an invalidation must not repopulate
+    cache.invalidate(1, 200);
+    cache.put(1, value, 190, 210, 50);
+    CHECK(cache.get(1, 220) == nullptr);
+    auto fresh = std::make_shared<const std::string>("v2");
+    cache.put(1, fresh, 205, 230, 50);
+    CHECK(cache.get(1, 240) == fresh);
+
+    cache.put(3, value, 0, 0, 0);  // ttl 0 disables caching
+    CHECK(cache.get(3, 0) == nullptr);
+}
+
 int main(int argc, char** argv) 
 {
     using namespace drogon;
@@ -30,3 +309,132 @@ int main(int argc, char** argv)
     thr.join();
     return status;
 }
+
+DROGON_TEST(OptimisticLockTest)
+{
+    using Kind = OptimisticLock::IfMatch::Kind;
+    CHECK(OptimisticLock::parseIfMatch("").kind == Kind::None);
+    CHECK(OptimisticLock::parseIfMatch(" * ").kind == Kind::Any);
+
+    auto tag = OptimisticLock::parseIfMatch(OptimisticLock::etag(7));
+    CHECK(tag.kind == Kind::Version);
+    CHECK(tag.version == 7);
+
+    // Weak tags never match under If-Match's strong comparison
+    CHECK(OptimisticLock::parseIfMatch("W/\"7\"").kind == Kind::Invalid);
+    CHECK(OptimisticLock::parseIfMatch("7").kind == Kind::Invalid);
+    CHECK(OptimisticLock::parseIfMatch("\"7x\"").kind == Kind::Invalid);
+    CHECK(OptimisticLock::parseIfMatch("\"7\", \"8\"").kind == Kind::Invalid);
+
+    CHECK(OptimisticLock::updateSql("t", "id", {"a", "b"}, true) ==
+          "update t set a = ?,b = ?,version = version + 1 where id = ? and version = ?");
+    CHECK(OptimisticLock::updateSql("t", "id", {}, false) ==
+          "update t set version = version + 1 where id = ?");
+}
+
+DROGON_TEST(WriteCoalescerTest)
+{
+    using Changes = std::map<std::string, int>;
+    using Coalescer = WriteCoalescer<int, Changes, int>;
+    std::vector<Changes> writes;
+    Coalescer::Finish pending;
+    Coalescer coalescer(
+        [](Changes &into, const Changes &later) {
+            for (const auto &[field, value] : later)
+                into[field] = value;
+        },
+        [&](const int &, Changes changes, Coalescer::Finish finish) {
+            writes.push_back(std::move(changes));
+            pending = std::move(finish);
+        });
+    std::vector<int> results;
+    auto collect = [&results](const int &result) { results.push_back(result); };
+
+    // Off an event loop the first change is written at once; changes made
+    // meanwhile are merged and written when it finishes
+    CHECK(coalescer.submit(1, {{"a", 1}}, collect, 0));
+    CHECK(coalescer.submit(1, {{"a", 2}}, collect, 0));
+    CHECK(!coalescer.submit(1, {{"b", 3}}, collect, 0));
+    CHECK(writes.size() == 1);
+    auto finish = pending;
+    finish(10);
+    CHECK(writes.size() == 2);
+    CHECK(writes[1] == (Changes{{"a", 2}, {"b", 3}}));
+    CHECK(results == std::vector<int>{10});
+    finish = pending;
+    finish(20);
+    CHECK(results == (std::vector<int>{10, 20, 20}));
+
+    // On a loop, everything submitted in one iteration is one write
+    writes.clear();
+    std::promise<std::vector<int>> done;
+    Coalescer immediate(
+        [](Changes &into, const Changes &later) {
+            for (const auto &[field, value] : later)
+                into[field] = value;
+        },
+        [&writes](const int &, Changes changes, Coalescer::Finish finish) {
+            writes.push_back(changes);
+            finish(changes["a"]);
+        });
+    drogon::app().getLoop()->queueInLoop([&immediate, &done]() {
+        auto out = std::make_shared<std::vector<int>>();
+        auto collect = [out, &done](const int &result) {
+            out->push_back(result);
+            if (out->size() == 3)
+                done.set_value(*out);
+        };
+        for (int value : {1, 2, 3})
+            immediate.submit(7, {{"a", value}}, collect, 0);
+    });
+    CHECK(done.get_future().get() == (std::vector<int>{3, 3, 3}));
+    CHECK(writes.size() == 1);
+}
+
+DROGON_TEST(BulkTargetTest)
+{
+    const std::vector<std::string> columns{"city", "country", "sort"};
+    std::vector<int32_t> ids;
+    Json::Value filter(Json::objectValue);
+
+    // sort is a SET column: filtered by its string value
+    Json::Value body;
+    body["filter"]["sort"] = "venue";
+    body["filter"]["city"] = "Porto";
+    CHECK(BulkTarget::parse(body, columns, ids, filter).empty());
+    CHECK(ids.empty());
+    CHECK(filter["sort"].asString() == "venue");
+    CHECK(BulkTarget::filterSql(filter) == "city = ? and sort = ?");
+
+    body["filter"]["sort"] = 3;
+    CHECK(!BulkTarget::parse(body, columns, ids, filter).empty());
+    body["filter"].removeMember("sort");
+    body["filter"]["name"] = "x";
+    CHECK(!BulkTarget::parse(body, columns, ids, filter).empty());
+
+    // ids or filter, not both
+    body["ids"].append(1);
+    CHECK(!BulkTarget::parse(body, columns, ids, filter).empty());
+    body.removeMember("filter");
+    body["ids"].append(3);
+    body["ids"].append(1);
+    CHECK(BulkTarget::parse(body, columns, ids, filter).empty());
+    CHECK(ids == (std::vector<int32_t>{1, 3}));
+    CHECK(BulkTarget::placeholders(3) == "?,?,?");
+}
+
+DROGON_TEST(SqlScriptTest)
+{
+    auto statements = SqlScript::split("-- comment\n"
+                                       "CREATE TABLE t (\n"
+                                       "    a INT\n"
+                                       ");\n"
+                                       "\n"
+                                       "  -- indented comment\n"
+                                       "CREATE INDEX i ON t (a);\n"
+                                       "SELECT 1");
+    CHECK(statements.size() == 3);
+    CHECK(statements[0] == "CREATE TABLE t (\n    a INT\n);\n");
+    CHECK(statements[1] == "CREATE INDEX i ON t (a);\n");
+    CHECK(statements[2] == "SELECT 1\n");
+}
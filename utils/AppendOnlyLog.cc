@@ -0,0 +1,77 @@
+#include "AppendOnlyLog.h"
+#include <cstdio>
+
+bool AppendOnlyLog::open(const std::string &path)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    path_ = path;
+    out_.open(path_, std::ios::out | std::ios::app);
+    return out_.is_open();
+}
+
+void AppendOnlyLog::replay(
+    const std::function<void(const std::string &)> &handler)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::ifstream in(path_);
+    std::string line;
+    while (std::getline(in, line))
+    {
+        if (!line.empty())
+            handler(line);
+    }
+}
+
+bool AppendOnlyLog::append(const std::string &record)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!out_.is_open())
+        return false;
+    out_ << record << '\n';
+    out_.flush();
+    return out_.good();
+}
+
+bool AppendOnlyLog::compact(const std::vector<std::string> &records)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return replace(records);
+}
+
+bool AppendOnlyLog::rewrite(
+    const std::function<std::vector<std::string>(std::vector<std::string>)> &reduce)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::vector<std::string> records;
+    {
+        std::ifstream in(path_);
+        std::string line;
+        while (std::getline(in, line))
+        {
+            if (!line.empty())
+                records.push_back(std::move(line));
+        }
+    }
+    return replace(reduce(std::move(records)));
+}
+
+// Called with mutex_ held
+bool AppendOnlyLog::replace(const std::vector<std::string> &records)
+{
+    auto tmpPath = path_ + ".tmp";
+    {
+        std::ofstream tmp(tmpPath, std::ios::out | std::ios::trunc);
+        if (!tmp.is_open())
+            return false;
+        for (const auto &record : records)
+            tmp << record << '\n';
+        tmp.flush();
+        if (!tmp.good())
+            return false;
+    }
+
+    out_.close();
+    bool renamed = std::rename(tmpPath.c_str(), path_.c_str()) == 0;
+    out_.open(path_, std::ios::out | std::ios::app);
+    return renamed && out_.is_open();
+}
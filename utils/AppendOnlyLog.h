@@ -0,0 +1,51 @@
+#pragma once
+
+#include <fstream>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Line-oriented append-only file used for restart recovery
+ *
+ * Records are single lines (callers must not embed '\n'). Appends are
+ * serialized by a mutex and flushed immediately; compact() and rewrite()
+ * atomically replace the file with a reduced set of records.
+ */
+class AppendOnlyLog
+{
+  public:
+    AppendOnlyLog() = default;
+    AppendOnlyLog(const AppendOnlyLog &) = delete;
+    AppendOnlyLog &operator=(const AppendOnlyLog &) = delete;
+
+    /// Open (creating if needed) the log at @p path for appending
+    bool open(const std::string &path);
+
+    bool isOpen() const
+    {
+        return out_.is_open();
+    }
+
+    /// Feed every record currently in the file to @p handler, in order
+    void replay(const std::function<void(const std::string &)> &handler);
+
+    /// Append one record
+    bool append(const std::string &record);
+
+    /// Replace the whole file with @p records (write to a temp file, rename)
+    bool compact(const std::vector<std::string> &records);
+
+    /// Replace the whole file with what @p reduce keeps of its records;
+    /// appends wait until the file is replaced, so none is lost
+    bool rewrite(
+        const std::function<std::vector<std::string>(std::vector<std::string>)> &reduce);
+
+  private:
+    bool replace(const std::vector<std::string> &records);
+
+    std::string path_;
+    std::ofstream out_;
+    std::mutex mutex_;
+};
@@ -0,0 +1,133 @@
+#pragma once
+
+#include <trantor/net/EventLoop.h>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief DataLoader-style batching of point lookups, per event loop
+ *
+ * load() queues a key on the calling thread's event loop; the first key of
+ * a batch arms a timer of @c windowSec, and the batch is fetched with one
+ * call to the Fetch function when the timer fires or as soon as it holds
+ * @c maxKeys distinct keys. A window of 0 batches whatever the loop
+ * handles in its current iteration. Duplicate keys in a batch are fetched
+ * once. Each loop owns its queue, so nothing here takes a lock; results
+ * are dispatched on whichever thread completes the fetch. Called off an
+ * event loop, load() fetches the single key immediately.
+ *
+ * Callbacks receive the value, or nullptr with @p failed false for a
+ * missing key and true when the whole fetch failed.
+ */
+template <typename Key, typename Value>
+class BatchLoader
+{
+  public:
+    using Callback = std::function<void(const Value *value, bool failed)>;
+    /// Complete a fetch: @p ok false fails every key of the batch
+    using Done = std::function<void(bool ok, std::unordered_map<Key, Value> found)>;
+    using Fetch = std::function<void(std::vector<Key> keys, Done done)>;
+
+    struct Options
+    {
+        double windowSec{0.001};
+        size_t maxKeys{100};
+    };
+
+    explicit BatchLoader(Fetch fetch) : fetch_(std::move(fetch))
+    {
+    }
+
+    void load(const Key &key, Callback callback, const Options &options)
+    {
+        auto *loop = trantor::EventLoop::getEventLoopOfCurrentThread();
+        if (!loop)
+        {
+            Waiting single;
+            single[key].push_back(std::move(callback));
+            run(std::move(single));
+            return;
+        }
+
+        auto &batch = localBatch();
+        auto &callbacks = batch.waiting[key];
+        callbacks.push_back(std::move(callback));
+        if (batch.waiting.size() >= options.maxKeys)
+        {
+            flush(batch);
+            return;
+        }
+        if (batch.armed)
+            return;
+        batch.armed = true;
+        auto generation = batch.generation;
+        auto flushLater = [this, &batch, generation]() {
+            // Skip if the batch was already flushed for being full
+            if (batch.generation == generation)
+                flush(batch);
+        };
+        if (options.windowSec > 0)
+            loop->runAfter(options.windowSec, std::move(flushLater));
+        else
+            loop->queueInLoop(std::move(flushLater));
+    }
+
+  private:
+    using Waiting = std::unordered_map<Key, std::vector<Callback>>;
+
+    struct Batch
+    {
+        Waiting waiting;
+        bool armed{false};
+        uint64_t generation{0};
+    };
+
+    // One batch per thread and loader; only that thread touches it
+    Batch &localBatch()
+    {
+        thread_local std::unordered_map<const BatchLoader *, std::unique_ptr<Batch>> batches;
+        auto &batch = batches[this];
+        if (!batch)
+            batch = std::make_unique<Batch>();
+        return *batch;
+    }
+
+    void flush(Batch &batch)
+    {
+        Waiting waiting;
+        waiting.swap(batch.waiting);
+        batch.armed = false;
+        ++batch.generation;
+        if (!waiting.empty())
+            run(std::move(waiting));
+    }
+
+    void run(Waiting waiting)
+    {
+        std::vector<Key> keys;
+        keys.reserve(waiting.size());
+        for (const auto &item : waiting)
+            keys.push_back(item.first);
+        auto shared = std::make_shared<Waiting>(std::move(waiting));
+        fetch_(std::move(keys), [shared](bool ok, std::unordered_map<Key, Value> found) {
+            for (auto &[key, callbacks] : *shared)
+            {
+                const Value *value = nullptr;
+                if (ok)
+                {
+                    auto it = found.find(key);
+                    if (it != found.end())
+                        value = &it->second;
+                }
+                for (auto &callback : callbacks)
+                    callback(value, !ok);
+            }
+        });
+    }
+
+    Fetch fetch_;
+};
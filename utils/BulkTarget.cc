@@ -0,0 +1,65 @@
+#include "BulkTarget.h"
+#include <algorithm>
+#include <unordered_set>
+
+namespace BulkTarget
+{
+std::string parse(const Json::Value &body,
+                  const std::vector<std::string> &filterColumns,
+                  std::vector<int32_t> &ids,
+                  Json::Value &filter)
+{
+    if (!body.isObject() || body.isMember("ids") == body.isMember("filter"))
+        return "Expected either \"ids\": [...] or \"filter\": {...}";
+
+    if (body.isMember("ids"))
+    {
+        if (!body["ids"].isArray() || body["ids"].empty())
+            return "ids must be a non-empty array";
+        std::unordered_set<int32_t> seen;
+        for (const auto &id : body["ids"])
+        {
+            if (!id.isInt())
+                return "ids must be integers";
+            if (seen.insert(id.asInt()).second)
+                ids.push_back(id.asInt());
+        }
+        return {};
+    }
+
+    // An empty filter would match the whole table
+    const auto &members = body["filter"];
+    if (!members.isObject() || members.empty())
+        return "filter must be a non-empty object";
+    for (const auto &column : members.getMemberNames())
+    {
+        if (std::find(filterColumns.begin(), filterColumns.end(), column) == filterColumns.end())
+        {
+            std::string allowed;
+            for (const auto &name : filterColumns)
+                allowed += (allowed.empty() ? "" : ", ") + name;
+            return "filter may only use " + allowed;
+        }
+        if (!members[column].isString())
+            return "filter." + column + " must be a string";
+        filter[column] = members[column];
+    }
+    return {};
+}
+
+std::string filterSql(const Json::Value &filter)
+{
+    std::string sql;
+    for (const auto &column : filter.getMemberNames())
+        sql += (sql.empty() ? "" : " and ") + column + " = ?";
+    return sql;
+}
+
+std::string placeholders(size_t count)
+{
+    std::string sql;
+    for (size_t i = 0; i < count; ++i)
+        sql += i == 0 ? "?" : ",?";
+    return sql;
+}
+}  // namespace BulkTarget
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <json/json.h>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Row selection for bulk writes: an id list or an equality filter
+ *
+ * A request body names its rows with {"ids": [...]} or {"filter": {...}},
+ * never both. Filter members are limited to a whitelist of columns, since
+ * their names end up in the SQL text, and must be strings: the whitelisted
+ * columns are text (or SET) columns, and a number would never match.
+ */
+namespace BulkTarget
+{
+/**
+ * Parse @p body into deduplicated @p ids or into @p filter, allowing only
+ * @p filterColumns in a filter.
+ * @return the message for a 400, empty if the body is valid
+ */
+std::string parse(const Json::Value &body,
+                  const std::vector<std::string> &filterColumns,
+                  std::vector<int32_t> &ids,
+                  Json::Value &filter);
+
+/// "city = ? and sort = ?" for the members of @p filter, bound in member order
+std::string filterSql(const Json::Value &filter);
+
+/// "?,?,?" for @p count parameters
+std::string placeholders(size_t count);
+}  // namespace BulkTarget
@@ -0,0 +1,114 @@
+#include "DbStats.h"
+#include "Metrics.h"
+#include <algorithm>
+#include <chrono>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+namespace
+{
+std::mutex registryMutex;
+std::map<std::string, std::unique_ptr<DbStats::Client>> registry;
+}  // namespace
+
+int64_t DbStats::nowUs()
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+DbStats::Client &DbStats::client(const std::string &name)
+{
+    // Clients are never removed, so each thread can keep raw pointers and
+    // only takes the registry lock the first time it sees a name.
+    thread_local std::unordered_map<std::string, Client *> cache;
+    auto it = cache.find(name);
+    if (it != cache.end())
+        return *it->second;
+
+    std::lock_guard<std::mutex> lock(registryMutex);
+    auto &entry = registry[name];
+    if (!entry)
+        entry = std::make_unique<Client>(name);
+    cache.emplace(name, entry.get());
+    return *entry;
+}
+
+std::vector<DbStats::Client *> DbStats::clients()
+{
+    std::lock_guard<std::mutex> lock(registryMutex);
+    std::vector<Client *> result;
+    for (auto &item : registry)
+        result.push_back(item.second.get());
+    return result;
+}
+
+void DbStats::configure(const Json::Value &dbClients)
+{
+    for (const auto &cfg : dbClients)
+    {
+        auto &stats = client(cfg.get("name", "default").asString());
+        stats.poolSize = cfg.get("number_of_connections",
+                                 cfg.get("connection_number", 1))
+                             .asUInt64();
+    }
+}
+
+DbStats::Query DbStats::start(std::string_view model,
+                              std::string_view operation,
+                              const Tracing::Span &parent,
+                              const std::string &name)
+{
+    auto &stats = client(name);
+    stats.inFlight.fetch_add(1, std::memory_order_relaxed);
+    return Query(&stats, model, operation, parent.child("db.query"), nowUs());
+}
+
+void DbStats::Query::done(bool ok) const
+{
+    auto now = nowUs();
+    client_->inFlight.fetch_sub(1, std::memory_order_relaxed);
+    client_->total.fetch_add(1, std::memory_order_relaxed);
+    if (!ok)
+        client_->errors.fetch_add(1, std::memory_order_relaxed);
+    client_->latency.record(now - startUs_, now);
+    Metrics::dbQueryDuration().observe({client_->name, model_, operation_, ok ? "ok" : "error"},
+                                       static_cast<double>(now - startUs_) / 1e6);
+    span_.end(nullptr, 0, !ok);
+}
+
+Json::Value DbStats::toJson()
+{
+    auto now = nowUs();
+    Json::Value json(Json::objectValue);
+    for (auto *stats : clients())
+    {
+        auto inFlight = std::max<int64_t>(0, stats->inFlight.load());
+        auto poolSize = static_cast<int64_t>(stats->poolSize.load());
+        auto latency = stats->latency.snapshot(now);
+
+        Json::Value item;
+        item["connections"] = static_cast<Json::Int64>(poolSize);
+        item["in_flight"] = static_cast<Json::Int64>(inFlight);
+        // Queries beyond the pool size are waiting in the client's queue
+        item["queued"] = static_cast<Json::Int64>(
+            poolSize > 0 ? std::max<int64_t>(0, inFlight - poolSize) : 0);
+        item["total"] = static_cast<Json::UInt64>(stats->total.load());
+        item["errors"] = static_cast<Json::UInt64>(stats->errors.load());
+
+        Json::Value lat;
+        lat["window_s"] = static_cast<Json::Int64>(stats->latency.windowUs() / 1000000);
+        lat["count"] = static_cast<Json::UInt64>(latency.count);
+        lat["p50_us"] = static_cast<Json::Int64>(latency.p50);
+        lat["p90_us"] = static_cast<Json::Int64>(latency.p90);
+        lat["p99_us"] = static_cast<Json::Int64>(latency.p99);
+        lat["max_us"] = static_cast<Json::Int64>(latency.max);
+        item["latency"] = lat;
+
+        json[stats->name] = item;
+    }
+    return json;
+}
@@ -0,0 +1,89 @@
+#pragma once
+
+#include "LatencyHistogram.h"
+#include "Tracing.h"
+#include <json/json.h>
+#include <atomic>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @brief Process-wide counters for database clients
+ *
+ * Drogon does not expose pool internals, so queries are tracked at the
+ * call site: DbStats::start() before handing a query to a DbClient or
+ * Mapper, and done() from whichever of the result/exception callbacks
+ * runs. Pool sizes come from the "db_clients" section of config.json.
+ * Completed queries are also fed to the db_query_duration_seconds metric,
+ * labelled by model and operation, and end a "db.query" child of the
+ * request span when one is passed.
+ *
+ * @code
+ * auto query = DbStats::start("cultural_nodes", "find");
+ * mapper->findAll([query, ...](...) { query.done(true); ... },
+ *                 [query, ...](...) { query.done(false); ... });
+ * @endcode
+ */
+class DbStats
+{
+  public:
+    struct Client
+    {
+        explicit Client(std::string n) : name(std::move(n))
+        {
+        }
+
+        const std::string name;
+        std::atomic<size_t> poolSize{0};
+        std::atomic<int64_t> inFlight{0};
+        std::atomic<uint64_t> total{0};
+        std::atomic<uint64_t> errors{0};
+        LatencyHistogram latency;
+    };
+
+    /// Copyable handle for one in-flight query
+    class Query
+    {
+      public:
+        Query(Client *client,
+              std::string_view model,
+              std::string_view operation,
+              Tracing::Span span,
+              int64_t startUs)
+            : client_(client),
+              model_(model),
+              operation_(operation),
+              span_(span),
+              startUs_(startUs)
+        {
+        }
+
+        /// Record completion; call exactly once
+        void done(bool ok) const;
+
+      private:
+        Client *client_;
+        std::string_view model_;
+        std::string_view operation_;
+        Tracing::Span span_;
+        int64_t startUs_;
+    };
+
+    /// @p model and @p operation must outlive the query (use literals)
+    static Query start(std::string_view model,
+                       std::string_view operation,
+                       const Tracing::Span &parent = Tracing::Span(),
+                       const std::string &client = "default");
+
+    /// Read pool sizes from the "db_clients" config array
+    static void configure(const Json::Value &dbClients);
+
+    static Client &client(const std::string &name);
+    static std::vector<Client *> clients();
+
+    /// Per-client pool usage and latency percentiles
+    static Json::Value toJson();
+
+    static int64_t nowUs();
+};
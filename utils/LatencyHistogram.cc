@@ -0,0 +1,101 @@
+#include "LatencyHistogram.h"
+#include <algorithm>
+
+LatencyHistogram::LatencyHistogram(int64_t windowUs)
+    : slotUs_(std::max<int64_t>(1, windowUs / static_cast<int64_t>(kSlots)))
+{
+}
+
+size_t LatencyHistogram::bucketIndex(int64_t valueUs)
+{
+    if (valueUs <= 0)
+        return 0;
+
+    auto value = static_cast<uint64_t>(valueUs);
+    size_t magnitude = 63 - static_cast<size_t>(__builtin_clzll(value));
+    size_t shift =
+        magnitude > kSubBucketBits ? magnitude - kSubBucketBits : 0;
+    auto index = shift * kSubBuckets + static_cast<size_t>(value >> shift);
+    return std::min(index, kBuckets - 1);
+}
+
+int64_t LatencyHistogram::bucketLowerBound(size_t index)
+{
+    if (index < 2 * kSubBuckets)
+        return static_cast<int64_t>(index);
+    auto shift = index / kSubBuckets - 1;
+    return static_cast<int64_t>((index - shift * kSubBuckets) << shift);
+}
+
+void LatencyHistogram::record(int64_t valueUs, int64_t nowUs)
+{
+    auto epoch = nowUs / slotUs_;
+    auto &slot = slots_[static_cast<size_t>(epoch) % kSlots];
+
+    auto seen = slot.epoch.load(std::memory_order_acquire);
+    if (seen != epoch)
+    {
+        // First writer of a new period recycles the slot
+        if (seen < epoch &&
+            slot.epoch.compare_exchange_strong(seen, epoch, std::memory_order_acq_rel))
+        {
+            for (auto &count : slot.counts)
+                count.store(0, std::memory_order_relaxed);
+            slot.max.store(0, std::memory_order_relaxed);
+        }
+        else if (seen > epoch)
+        {
+            return;  // a newer period already owns the slot
+        }
+    }
+
+    slot.counts[bucketIndex(valueUs)].fetch_add(1, std::memory_order_relaxed);
+    auto max = slot.max.load(std::memory_order_relaxed);
+    while (valueUs > max &&
+           !slot.max.compare_exchange_weak(max, valueUs, std::memory_order_relaxed))
+    {
+    }
+}
+
+LatencyHistogram::Snapshot LatencyHistogram::snapshot(int64_t nowUs) const
+{
+    auto current = nowUs / slotUs_;
+    std::array<uint64_t, kBuckets> merged{};
+    Snapshot snap;
+    for (const auto &slot : slots_)
+    {
+        auto epoch = slot.epoch.load(std::memory_order_acquire);
+        if (epoch < 0 || epoch > current || current - epoch >= static_cast<int64_t>(kSlots))
+            continue;
+        for (size_t i = 0; i < kBuckets; ++i)
+        {
+            auto count = slot.counts[i].load(std::memory_order_relaxed);
+            merged[i] += count;
+            snap.count += count;
+        }
+        snap.max = std::max(snap.max, slot.max.load(std::memory_order_relaxed));
+    }
+    if (snap.count == 0)
+        return snap;
+
+    auto percentile = [&merged, &snap](double q) {
+        auto rank = static_cast<uint64_t>(q * static_cast<double>(snap.count - 1)) + 1;
+        uint64_t seen = 0;
+        for (size_t i = 0; i < kBuckets; ++i)
+        {
+            seen += merged[i];
+            if (seen >= rank)
+            {
+                // Report the bucket midpoint, capped by the observed max
+                auto lo = bucketLowerBound(i);
+                auto hi = i + 1 < kBuckets ? bucketLowerBound(i + 1) : lo;
+                return std::min(lo + (hi - lo) / 2, snap.max);
+            }
+        }
+        return snap.max;
+    };
+    snap.p50 = percentile(0.50);
+    snap.p90 = percentile(0.90);
+    snap.p99 = percentile(0.99);
+    return snap;
+}
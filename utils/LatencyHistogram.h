@@ -0,0 +1,60 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief Rolling HDR-style latency histogram (microseconds)
+ *
+ * Log-linear buckets: 16 linear sub-buckets per power of two, so any
+ * reported percentile is within ~6% of the true value, from 1us up to
+ * ~130s (larger values are clamped). The window is split into time slots
+ * that are recycled as time advances, so percentiles describe roughly the
+ * last @p windowUs microseconds.
+ *
+ * record() is lock-free (relaxed atomics). Samples racing with a slot
+ * rotation may be lost, which is acceptable for monitoring.
+ */
+class LatencyHistogram
+{
+  public:
+    static constexpr size_t kSubBucketBits = 4;
+    static constexpr size_t kSubBuckets = size_t(1) << kSubBucketBits;
+    static constexpr size_t kBuckets = 24 * kSubBuckets;
+    static constexpr size_t kSlots = 6;
+
+    struct Snapshot
+    {
+        uint64_t count{0};
+        int64_t p50{0};
+        int64_t p90{0};
+        int64_t p99{0};
+        int64_t max{0};
+    };
+
+    explicit LatencyHistogram(int64_t windowUs = 60 * 1000000LL);
+
+    void record(int64_t valueUs, int64_t nowUs);
+    Snapshot snapshot(int64_t nowUs) const;
+
+    int64_t windowUs() const
+    {
+        return slotUs_ * static_cast<int64_t>(kSlots);
+    }
+
+    static size_t bucketIndex(int64_t valueUs);
+    static int64_t bucketLowerBound(size_t index);
+
+  private:
+    struct Slot
+    {
+        std::atomic<int64_t> epoch{-1};
+        std::atomic<int64_t> max{0};
+        std::array<std::atomic<uint64_t>, kBuckets> counts{};
+    };
+
+    int64_t slotUs_;
+    std::array<Slot, kSlots> slots_;
+};
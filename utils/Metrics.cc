@@ -0,0 +1,331 @@
+#include "Metrics.h"
+#include <algorithm>
+#include <cstdio>
+#include <deque>
+#include <map>
+#include <unordered_map>
+
+namespace
+{
+std::atomic<size_t> nextFamilyId{0};
+
+void appendNumber(std::string &out, double value)
+{
+    char buf[32];
+    auto len = std::snprintf(buf, sizeof(buf), "%.9g", value);
+    out.append(buf, static_cast<size_t>(len));
+}
+
+void appendLabels(std::string &out,
+                  const std::vector<std::string> &names,
+                  const std::vector<std::string> &values,
+                  const char *le = nullptr)
+{
+    if (names.empty() && !le)
+        return;
+    out += '{';
+    for (size_t i = 0; i < names.size(); ++i)
+    {
+        if (i > 0)
+            out += ',';
+        out += names[i];
+        out += "=\"";
+        Metrics::appendEscaped(out, values[i]);
+        out += '"';
+    }
+    if (le)
+    {
+        if (!names.empty())
+            out += ',';
+        out += "le=\"";
+        out += le;
+        out += '"';
+    }
+    out += '}';
+}
+}  // namespace
+
+struct MetricFamily::Series
+{
+    Series(std::vector<std::string> values, size_t bucketCount)
+        : labelValues(std::move(values)),
+          buckets(new std::atomic<uint64_t>[bucketCount]())
+    {
+    }
+
+    const std::vector<std::string> labelValues;
+    std::atomic<uint64_t> count{0};
+    std::atomic<double> sum{0};
+    // Non-cumulative; the +Inf bucket is count minus the rest
+    std::unique_ptr<std::atomic<uint64_t>[]> buckets;
+};
+
+struct MetricFamily::Shard
+{
+    // Owner thread only
+    std::unordered_map<std::string, Series *> index;
+
+    // Appended by the owner, walked by scrapes
+    std::mutex mutex;
+    std::deque<Series> series;
+};
+
+MetricFamily::MetricFamily(std::string name,
+                           std::string help,
+                           Type type,
+                           std::vector<std::string> labelNames,
+                           std::vector<double> buckets)
+    : id_(nextFamilyId++),
+      name_(std::move(name)),
+      help_(std::move(help)),
+      type_(type),
+      labelNames_(std::move(labelNames)),
+      buckets_(type == Type::Histogram ? std::move(buckets) : std::vector<double>{})
+{
+}
+
+MetricFamily::~MetricFamily() = default;
+
+MetricFamily::Shard &MetricFamily::localShard()
+{
+    // Family ids are never reused, so a stale slot can't alias a new family
+    thread_local std::vector<Shard *> local;
+    if (id_ >= local.size())
+        local.resize(id_ + 1, nullptr);
+    auto *&shard = local[id_];
+    if (!shard)
+    {
+        std::lock_guard<std::mutex> lock(shardsMutex_);
+        shards_.push_back(std::make_unique<Shard>());
+        shard = shards_.back().get();
+    }
+    return *shard;
+}
+
+MetricFamily::Series &MetricFamily::series(std::initializer_list<std::string_view> labels)
+{
+    auto &shard = localShard();
+
+    thread_local std::string key;
+    key.clear();
+    for (auto label : labels)
+    {
+        key.append(label.data(), label.size());
+        key += '\xff';
+    }
+
+    auto it = shard.index.find(key);
+    if (it != shard.index.end())
+        return *it->second;
+
+    std::vector<std::string> values(labels.begin(), labels.end());
+    values.resize(labelNames_.size());
+    Series *created;
+    {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        shard.series.emplace_back(std::move(values), buckets_.size());
+        created = &shard.series.back();
+    }
+    shard.index.emplace(key, created);
+    return *created;
+}
+
+void MetricFamily::inc(std::initializer_list<std::string_view> labels, uint64_t n)
+{
+    series(labels).count.fetch_add(n, std::memory_order_relaxed);
+}
+
+void MetricFamily::observe(std::initializer_list<std::string_view> labels, double value)
+{
+    auto &s = series(labels);
+    auto bucket = static_cast<size_t>(
+        std::lower_bound(buckets_.begin(), buckets_.end(), value) - buckets_.begin());
+    if (bucket < buckets_.size())
+        s.buckets[bucket].fetch_add(1, std::memory_order_relaxed);
+    // Only the owning thread writes a series, so load+store is enough
+    s.sum.store(s.sum.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+    s.count.fetch_add(1, std::memory_order_relaxed);
+}
+
+void MetricFamily::render(std::string &out) const
+{
+    struct Merged
+    {
+        std::vector<uint64_t> buckets;
+        uint64_t count{0};
+        double sum{0};
+    };
+    std::map<std::vector<std::string>, Merged> merged;
+
+    {
+        std::lock_guard<std::mutex> lock(shardsMutex_);
+        for (const auto &shard : shards_)
+        {
+            std::lock_guard<std::mutex> shardLock(shard->mutex);
+            for (const auto &s : shard->series)
+            {
+                auto &m = merged[s.labelValues];
+                m.buckets.resize(buckets_.size());
+                for (size_t i = 0; i < buckets_.size(); ++i)
+                    m.buckets[i] += s.buckets[i].load(std::memory_order_relaxed);
+                m.count += s.count.load(std::memory_order_relaxed);
+                m.sum += s.sum.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    out += "# HELP " + name_ + " " + help_ + "\n";
+    out += "# TYPE " + name_ + (type_ == Type::Counter ? " counter\n" : " histogram\n");
+    for (const auto &[labels, m] : merged)
+    {
+        if (type_ == Type::Counter)
+        {
+            out += name_;
+            appendLabels(out, labelNames_, labels);
+            out += ' ';
+            out += std::to_string(m.count);
+            out += '\n';
+            continue;
+        }
+
+        uint64_t cumulative = 0;
+        for (size_t i = 0; i < buckets_.size(); ++i)
+        {
+            cumulative += m.buckets[i];
+            std::string le;
+            appendNumber(le, buckets_[i]);
+            out += name_ + "_bucket";
+            appendLabels(out, labelNames_, labels, le.c_str());
+            out += ' ' + std::to_string(cumulative) + '\n';
+        }
+        out += name_ + "_bucket";
+        appendLabels(out, labelNames_, labels, "+Inf");
+        out += ' ' + std::to_string(m.count) + '\n';
+
+        out += name_ + "_sum";
+        appendLabels(out, labelNames_, labels);
+        out += ' ';
+        appendNumber(out, m.sum);
+        out += '\n';
+
+        out += name_ + "_count";
+        appendLabels(out, labelNames_, labels);
+        out += ' ' + std::to_string(m.count) + '\n';
+    }
+}
+
+namespace
+{
+struct Callback
+{
+    std::string name;
+    std::string help;
+    std::string type;
+    std::function<double()> sample;
+};
+
+std::mutex callbacksMutex;
+std::vector<Callback> callbacks;
+}  // namespace
+
+const std::vector<double> &Metrics::latencyBuckets()
+{
+    static const std::vector<double> buckets{
+        0.0005, 0.001, 0.0025, 0.005, 0.01, 0.025, 0.05, 0.1, 0.25, 0.5, 1, 2.5, 5, 10};
+    return buckets;
+}
+
+MetricFamily &Metrics::httpRequestDuration()
+{
+    static MetricFamily family("http_request_duration_seconds",
+                               "HTTP request latency by route and status",
+                               MetricFamily::Type::Histogram,
+                               {"method", "route", "status"},
+                               latencyBuckets());
+    return family;
+}
+
+MetricFamily &Metrics::dbQueryDuration()
+{
+    static MetricFamily family("db_query_duration_seconds",
+                               "Database query latency by model and operation",
+                               MetricFamily::Type::Histogram,
+                               {"client", "model", "operation", "outcome"},
+                               latencyBuckets());
+    return family;
+}
+
+MetricFamily &Metrics::coalescedRequests()
+{
+    static MetricFamily family("http_requests_coalesced_total",
+                               "Requests served by a concurrent identical request's query",
+                               MetricFamily::Type::Counter,
+                               {"operation"});
+    return family;
+}
+
+MetricFamily &Metrics::batchSize()
+{
+    static MetricFamily family("db_batch_size",
+                               "Keys resolved per batched query",
+                               MetricFamily::Type::Histogram,
+                               {"operation"},
+                               {1, 2, 5, 10, 20, 50, 100, 200, 500});
+    return family;
+}
+
+MetricFamily &Metrics::skippedWrites()
+{
+    static MetricFamily family("db_writes_skipped_total",
+                               "Writes not sent because they would not change the row",
+                               MetricFamily::Type::Counter,
+                               {"operation"});
+    return family;
+}
+
+void Metrics::addCallback(std::string name,
+                          std::string help,
+                          std::string type,
+                          std::function<double()> sample)
+{
+    std::lock_guard<std::mutex> lock(callbacksMutex);
+    callbacks.push_back(
+        {std::move(name), std::move(help), std::move(type), std::move(sample)});
+}
+
+std::string Metrics::render()
+{
+    std::string out;
+    out.reserve(16 * 1024);
+    httpRequestDuration().render(out);
+    dbQueryDuration().render(out);
+    coalescedRequests().render(out);
+    batchSize().render(out);
+    skippedWrites().render(out);
+
+    std::lock_guard<std::mutex> lock(callbacksMutex);
+    for (const auto &cb : callbacks)
+    {
+        out += "# HELP " + cb.name + " " + cb.help + "\n";
+        out += "# TYPE " + cb.name + " " + cb.type + "\n";
+        out += cb.name + ' ';
+        appendNumber(out, cb.sample());
+        out += '\n';
+    }
+    return out;
+}
+
+void Metrics::appendEscaped(std::string &out, std::string_view value)
+{
+    for (char c : value)
+    {
+        if (c == '\\')
+            out += "\\\\";
+        else if (c == '"')
+            out += "\\\"";
+        else if (c == '\n')
+            out += "\\n";
+        else
+            out += c;
+    }
+}
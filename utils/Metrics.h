@@ -0,0 +1,109 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @brief Counter/histogram family rendered in Prometheus text format
+ *
+ * Every thread records into its own shard. The owning thread resolves a
+ * label set through a thread-private index and bumps relaxed atomics, so
+ * the steady-state hot path takes no lock; the shard mutex is only taken
+ * the first time a thread sees a label set and while a scrape walks the
+ * shard. Shards outlive their threads so counters stay monotonic.
+ */
+class MetricFamily
+{
+  public:
+    enum class Type
+    {
+        Counter,
+        Histogram
+    };
+
+    MetricFamily(std::string name,
+                 std::string help,
+                 Type type,
+                 std::vector<std::string> labelNames,
+                 std::vector<double> buckets = {});
+    ~MetricFamily();
+
+    MetricFamily(const MetricFamily &) = delete;
+    MetricFamily &operator=(const MetricFamily &) = delete;
+
+    /// Counter: add @p n to the series for @p labels
+    void inc(std::initializer_list<std::string_view> labels, uint64_t n = 1);
+
+    /// Histogram: record @p value (seconds) for @p labels
+    void observe(std::initializer_list<std::string_view> labels, double value);
+
+    /// Merge all shards and append the text exposition to @p out
+    void render(std::string &out) const;
+
+    const std::string &name() const
+    {
+        return name_;
+    }
+
+  private:
+    struct Series;
+    struct Shard;
+
+    Series &series(std::initializer_list<std::string_view> labels);
+    Shard &localShard();
+
+    const size_t id_;
+    const std::string name_;
+    const std::string help_;
+    const Type type_;
+    const std::vector<std::string> labelNames_;
+    const std::vector<double> buckets_;
+
+    mutable std::mutex shardsMutex_;
+    std::vector<std::unique_ptr<Shard>> shards_;
+};
+
+/**
+ * @brief Process-wide metrics used by the /metrics endpoint
+ */
+namespace Metrics
+{
+/// Default latency buckets in seconds (500us .. 10s)
+const std::vector<double> &latencyBuckets();
+
+/// http_request_duration_seconds{method,route,status}
+MetricFamily &httpRequestDuration();
+
+/// db_query_duration_seconds{client,model,operation,outcome}
+MetricFamily &dbQueryDuration();
+
+/// http_requests_coalesced_total{operation}: requests answered by another
+/// request's in-flight query
+MetricFamily &coalescedRequests();
+
+/// db_writes_skipped_total{operation}: writes dropped because nothing changed
+MetricFamily &skippedWrites();
+
+/// db_batch_size{operation}: keys resolved per batched query
+MetricFamily &batchSize();
+
+/// Value sampled at scrape time, for state owned elsewhere (gauges and
+/// counters that another component already maintains)
+void addCallback(std::string name,
+                 std::string help,
+                 std::string type,
+                 std::function<double()> sample);
+
+/// Full text exposition of every family and callback
+std::string render();
+
+/// Escape a label value for the text format
+void appendEscaped(std::string &out, std::string_view value);
+}  // namespace Metrics
@@ -0,0 +1,56 @@
+#include "OptimisticLock.h"
+#include <charconv>
+
+namespace OptimisticLock
+{
+IfMatch parseIfMatch(std::string_view header)
+{
+    auto trim = [](std::string_view s) {
+        while (!s.empty() && (s.front() == ' ' || s.front() == '\t'))
+            s.remove_prefix(1);
+        while (!s.empty() && (s.back() == ' ' || s.back() == '\t'))
+            s.remove_suffix(1);
+        return s;
+    };
+    header = trim(header);
+    IfMatch result;
+    if (header.empty())
+        return result;
+    result.kind = IfMatch::Kind::Invalid;
+    if (header == "*")
+    {
+        result.kind = IfMatch::Kind::Any;
+        return result;
+    }
+    // If-Match uses strong comparison, so a weak tag can never match
+    if (header.size() < 3 || header.front() != '"' || header.back() != '"')
+        return result;
+    auto tag = header.substr(1, header.size() - 2);
+    int32_t version = 0;
+    auto [end, ec] = std::from_chars(tag.data(), tag.data() + tag.size(), version);
+    if (ec != std::errc() || end != tag.data() + tag.size() || version < 0)
+        return result;
+    result.kind = IfMatch::Kind::Version;
+    result.version = version;
+    return result;
+}
+
+std::string etag(int32_t version)
+{
+    return "\"" + std::to_string(version) + "\"";
+}
+
+std::string updateSql(const std::string &table,
+                      const std::string &primaryKey,
+                      const std::vector<std::string> &columns,
+                      bool checkVersion)
+{
+    std::string sql = "update " + table + " set ";
+    for (const auto &column : columns)
+        sql += column + " = ?,";
+    sql += "version = version + 1 where " + primaryKey + " = ?";
+    if (checkVersion)
+        sql += " and version = ?";
+    return sql;
+}
+}  // namespace OptimisticLock
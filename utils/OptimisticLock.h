@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @brief Version-checked writes for tables with a @c version column
+ *
+ * Every write bumps the row's version in the same statement, and a
+ * conditional write names the version it was based on in its WHERE clause
+ * (compare-and-swap). Zero affected rows then means either the row is gone
+ * or someone else wrote first; nothing is locked while the client edits.
+ * The version is exposed to HTTP clients as a strong ETag ("3").
+ */
+namespace OptimisticLock
+{
+struct IfMatch
+{
+    enum class Kind
+    {
+        None,     // header absent: write unconditionally
+        Any,      // "*": the row only has to exist
+        Version,  // "3": the row must still be at @c version
+        Invalid   // weak tag, list or not a version we issued
+    };
+    Kind kind{Kind::None};
+    int32_t version{0};
+};
+
+/// Parse an If-Match header value
+IfMatch parseIfMatch(std::string_view header);
+
+/// ETag header value for @p version
+std::string etag(int32_t version);
+
+/**
+ * UPDATE @p table SET each of @p columns = ?, version = version + 1
+ * WHERE @p primaryKey = ? [AND version = ?]. Arguments bind in that order.
+ */
+std::string updateSql(const std::string &table,
+                      const std::string &primaryKey,
+                      const std::vector<std::string> &columns,
+                      bool checkVersion);
+}  // namespace OptimisticLock
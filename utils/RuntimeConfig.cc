@@ -0,0 +1,392 @@
+#include "RuntimeConfig.h"
+#include <trantor/utils/Logger.h>
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <charconv>
+#include <cstdlib>
+#include <fstream>
+#include <mutex>
+#include <type_traits>
+
+namespace
+{
+std::mutex publishMutex;
+std::shared_ptr<const RuntimeConfig> published = std::make_shared<RuntimeConfig>();
+uint64_t lastVersion = 0;                       // guarded by publishMutex
+std::atomic<uint64_t> publishedVersion{0};
+
+struct ThreadCache
+{
+    std::shared_ptr<const RuntimeConfig> config;
+    uint64_t version{UINT64_MAX};
+};
+
+ThreadCache &threadCache()
+{
+    thread_local ThreadCache cache;
+    auto version = publishedVersion.load(std::memory_order_acquire);
+    if (cache.version != version)
+    {
+        std::lock_guard<std::mutex> lock(publishMutex);
+        cache.config = published;
+        cache.version = cache.config->version;
+    }
+    return cache;
+}
+
+const Json::Value *findPath(const Json::Value &root, std::string_view path)
+{
+    const Json::Value *node = &root;
+    for (;;)
+    {
+        auto dot = path.find('.');
+        auto part = path.substr(0, dot);
+        if (!node->isObject())
+            return nullptr;
+        node = node->find(part.data(), part.data() + part.size());
+        if (!node || dot == std::string_view::npos)
+            return node;
+        path.remove_prefix(dot + 1);
+    }
+}
+
+std::string_view trim(std::string_view text)
+{
+    auto begin = text.find_first_not_of(" \t");
+    if (begin == std::string_view::npos)
+        return {};
+    auto end = text.find_last_not_of(" \t");
+    return text.substr(begin, end - begin + 1);
+}
+
+// Parsers leave @p out untouched on failure so the default survives
+
+template <typename T>
+bool parse(const std::string &text, T &out)
+{
+    static_assert(std::is_integral_v<T>);
+    auto value = trim(text);
+    T parsed;
+    auto [end, ec] = std::from_chars(value.data(), value.data() + value.size(), parsed);
+    if (ec != std::errc() || end != value.data() + value.size() || value.empty())
+        return false;
+    out = parsed;
+    return true;
+}
+
+bool parse(const std::string &text, double &out)
+{
+    std::string value(trim(text));
+    char *end = nullptr;
+    errno = 0;
+    double parsed = std::strtod(value.c_str(), &end);
+    if (value.empty() || errno || *end)
+        return false;
+    out = parsed;
+    return true;
+}
+
+bool parse(const std::string &text, std::string &out)
+{
+    out = text;
+    return true;
+}
+
+bool parse(const std::string &text, RuntimeConfig::StringList &out)
+{
+    RuntimeConfig::StringList parsed;
+    std::string_view rest(text);
+    while (!rest.empty())
+    {
+        auto comma = rest.find(',');
+        auto item = trim(rest.substr(0, comma));
+        if (!item.empty())
+            parsed.emplace_back(item);
+        if (comma == std::string_view::npos)
+            break;
+        rest.remove_prefix(comma + 1);
+    }
+    out = std::move(parsed);
+    return true;
+}
+
+bool parse(const Json::Value &json, int &out)
+{
+    if (!json.isInt())
+        return false;
+    out = json.asInt();
+    return true;
+}
+
+bool parse(const Json::Value &json, int64_t &out)
+{
+    if (!json.isInt64())
+        return false;
+    out = json.asInt64();
+    return true;
+}
+
+bool parse(const Json::Value &json, double &out)
+{
+    if (!json.isNumeric())
+        return false;
+    out = json.asDouble();
+    return true;
+}
+
+bool parse(const Json::Value &json, std::string &out)
+{
+    if (!json.isString())
+        return false;
+    out = json.asString();
+    return true;
+}
+
+bool parse(const Json::Value &json, RuntimeConfig::StringList &out)
+{
+    if (!json.isArray())
+        return false;
+    RuntimeConfig::StringList parsed;
+    for (const auto &item : json)
+    {
+        if (!item.isString())
+            return false;
+        parsed.push_back(item.asString());
+    }
+    out = std::move(parsed);
+    return true;
+}
+
+template <typename T>
+const char *typeName()
+{
+    if constexpr (std::is_same_v<T, double>)
+        return "a number";
+    else if constexpr (std::is_integral_v<T>)
+        return "an integer";
+    else if constexpr (std::is_same_v<T, std::string>)
+        return "a string";
+    else
+        return "a list of strings";
+}
+
+template <typename T>
+void load(T &out,
+          const char *path,
+          const char *env,
+          const Json::Value &customConfig,
+          const std::map<std::string, std::string> &dotenv,
+          std::vector<std::string> &errors)
+{
+    auto it = dotenv.find(env);
+    if (it != dotenv.end())
+    {
+        if (!parse(it->second, out))
+            errors.push_back(std::string(".env ") + env + ": expected " + typeName<T>());
+        return;
+    }
+    // Only read while building a snapshot, never on a request path
+    if (const char *value = std::getenv(env))
+    {
+        if (!parse(std::string(value), out))
+            errors.push_back(std::string("environment ") + env + ": expected " + typeName<T>());
+        return;
+    }
+    if (!path)
+        return;
+    auto *value = findPath(customConfig, path);
+    if (value && !value->isNull() && !parse(*value, out))
+        errors.push_back(std::string("custom_config.") + path + ": expected " + typeName<T>());
+}
+
+template <typename T>
+void require(bool ok, T &member, T defaultValue, const char *what, std::vector<std::string> &errors)
+{
+    if (ok)
+        return;
+    errors.push_back(what);
+    member = defaultValue;
+}
+}  // namespace
+
+bool RuntimeConfig::originRejected(std::string_view origin) const
+{
+    for (const auto &rejected : corsRejectedOrigins)
+        if (!rejected.empty() && origin.find(rejected) != std::string_view::npos)
+            return true;
+    return false;
+}
+
+bool RuntimeConfig::originAllowed(std::string_view origin) const
+{
+    if (corsAllowedOrigins.empty())
+        return true;
+    for (const auto &allowed : corsAllowedOrigins)
+        if (origin == allowed)
+            return true;
+    return false;
+}
+
+std::shared_ptr<RuntimeConfig> RuntimeConfig::build(
+    const Json::Value &customConfig,
+    const std::map<std::string, std::string> &dotenv,
+    std::vector<std::string> &errors)
+{
+    auto config = std::make_shared<RuntimeConfig>();
+#define RUNTIME_CONFIG_LOAD(name, type, path, env, defaultValue) \
+    load(config->name, path, env, customConfig, dotenv, errors);
+    RUNTIME_CONFIG_KEYS(RUNTIME_CONFIG_LOAD)
+#undef RUNTIME_CONFIG_LOAD
+
+    const RuntimeConfig defaults;
+    require(config->rateLimitIntervalSec >= 0,
+            config->rateLimitIntervalSec,
+            defaults.rateLimitIntervalSec,
+            "rate_limit.min_interval_sec must not be negative",
+            errors);
+    require(config->maxPageSize > 0,
+            config->maxPageSize,
+            defaults.maxPageSize,
+            "pagination.max_limit must be positive",
+            errors);
+    require(config->defaultPageSize > 0 && config->defaultPageSize <= config->maxPageSize,
+            config->defaultPageSize,
+            std::min(defaults.defaultPageSize, config->maxPageSize),
+            "pagination.default_limit must be between 1 and pagination.max_limit",
+            errors);
+    require(config->dbHealthCacheTtlMs >= 0,
+            config->dbHealthCacheTtlMs,
+            defaults.dbHealthCacheTtlMs,
+            "db_health.cache_ttl_ms must not be negative",
+            errors);
+    require(config->accessTokenTtl > 0,
+            config->accessTokenTtl,
+            defaults.accessTokenTtl,
+            "auth.access_token_ttl must be positive",
+            errors);
+
+    require(config->batchWindowMs >= 0,
+            config->batchWindowMs,
+            defaults.batchWindowMs,
+            "batching.window_ms must not be negative",
+            errors);
+    require(config->batchMaxIds > 0,
+            config->batchMaxIds,
+            defaults.batchMaxIds,
+            "batching.max_ids must be positive",
+            errors);
+    require(config->nodeCacheTtlMs >= 0,
+            config->nodeCacheTtlMs,
+            defaults.nodeCacheTtlMs,
+            "cache.node_ttl_ms must not be negative",
+            errors);
+    require(config->multiGetMaxIds > 0,
+            config->multiGetMaxIds,
+            defaults.multiGetMaxIds,
+            "multiget.max_ids must be positive",
+            errors);
+    require(config->upsertMaxRows > 0,
+            config->upsertMaxRows,
+            defaults.upsertMaxRows,
+            "upsert.max_rows must be positive",
+            errors);
+    require(config->historyMaxRows > 0,
+            config->historyMaxRows,
+            defaults.historyMaxRows,
+            "history.max_rows must be positive",
+            errors);
+    require(config->writeCoalesceMs >= 0,
+            config->writeCoalesceMs,
+            defaults.writeCoalesceMs,
+            "write_coalescing.window_ms must not be negative",
+            errors);
+    require(config->bulkMaxRows > 0,
+            config->bulkMaxRows,
+            defaults.bulkMaxRows,
+            "bulk.max_rows must be positive",
+            errors);
+
+    // <user>:<salt>:<64 hex digits of SHA-256(salt + password)>
+    for (const auto &entry : config->authUsers)
+    {
+        auto first = entry.find(':');
+        auto second = first == std::string::npos ? first : entry.find(':', first + 1);
+        if (first == 0 || second == std::string::npos || entry.size() - second - 1 != 64 ||
+            entry.find_first_not_of("0123456789abcdefABCDEF", second + 1) != std::string::npos)
+        {
+            errors.push_back("AUTH_USERS entries must be <user>:<salt>:<sha256 hex>");
+            config->authUsers = defaults.authUsers;
+            break;
+        }
+    }
+
+    if (config->jwtSecret.empty())
+        LOG_ERROR << "JWT_SECRET is not set, bearer tokens are disabled";
+    if (config->authUsers.empty())
+        LOG_ERROR << "AUTH_USERS is not set, every login is refused";
+    return config;
+}
+
+std::map<std::string, std::string> RuntimeConfig::loadEnvFile(const std::string &path)
+{
+    std::map<std::string, std::string> env;
+    std::ifstream file(path);
+    if (!file)
+    {
+        LOG_WARN << "Cannot load " << path << ", using system environment";
+        return env;
+    }
+
+    std::string line;
+    int lineNum = 0;
+    while (std::getline(file, line))
+    {
+        ++lineNum;
+        auto text = trim(line);
+        if (text.empty() || text[0] == '#')
+            continue;
+        auto pos = text.find('=');
+        if (pos == std::string_view::npos)
+        {
+            LOG_WARN << "Invalid format in " << path << " at line " << lineNum
+                     << ": missing '=' separator";
+            continue;
+        }
+        auto key = trim(text.substr(0, pos));
+        auto value = trim(text.substr(pos + 1));
+        if (value.size() >= 2 && (value.front() == '"' || value.front() == '\'') &&
+            value.back() == value.front())
+            value = value.substr(1, value.size() - 2);
+        if (!key.empty())
+            env[std::string(key)] = std::string(value);
+    }
+    LOG_INFO << "Loaded " << env.size() << " environment variables from " << path;
+    return env;
+}
+
+const RuntimeConfig &RuntimeConfig::current()
+{
+    return *threadCache().config;
+}
+
+std::shared_ptr<const RuntimeConfig> RuntimeConfig::snapshot()
+{
+    return threadCache().config;
+}
+
+uint64_t RuntimeConfig::publish(std::shared_ptr<RuntimeConfig> config)
+{
+    std::shared_ptr<const RuntimeConfig> previous;
+    uint64_t version;
+    {
+        std::lock_guard<std::mutex> lock(publishMutex);
+        version = config->version = ++lastVersion;
+        previous = std::move(published);
+        published = std::move(config);
+        publishedVersion.store(version, std::memory_order_release);
+    }
+    // previous is released outside the lock; readers still holding it keep
+    // it alive until their next current()
+    return version;
+}
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <json/json.h>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * Every runtime setting, one line each:
+ * X(member, type, custom_config path, environment variable, default)
+ *
+ * A value is taken from the first source that has it: .env, the process
+ * environment, config.json (custom_config), then the default. Environment
+ * values are parsed into the member's type (lists are comma-separated); a
+ * value that doesn't parse is reported by build() rather than ignored.
+ */
+#define RUNTIME_CONFIG_KEYS(X)                                                                \
+    X(rateLimitIntervalSec, double, "rate_limit.min_interval_sec",                            \
+      "RATE_LIMIT_MIN_INTERVAL_SEC", 10)                                                      \
+    X(corsAllowedOrigins, StringList, "cors.allowed_origins", "CORS_ALLOWED_ORIGINS", {})     \
+    X(corsRejectedOrigins, StringList, "cors.rejected_origins", "CORS_REJECTED_ORIGINS",      \
+      StringList{"www.some-evil-place.com"})                                                  \
+    X(defaultPageSize, int, "pagination.default_limit", "PAGINATION_DEFAULT_LIMIT", 20)       \
+    X(maxPageSize, int, "pagination.max_limit", "PAGINATION_MAX_LIMIT", 100)                  \
+    X(dbHealthCacheTtlMs, int64_t, "db_health.cache_ttl_ms", "DB_HEALTH_CACHE_TTL_MS", 1000)  \
+    X(accessTokenTtl, int64_t, "auth.access_token_ttl", "ACCESS_TOKEN_TTL", 900)              \
+    X(batchWindowMs, double, "batching.window_ms", "BATCH_WINDOW_MS", 1)                      \
+    X(batchMaxIds, int, "batching.max_ids", "BATCH_MAX_IDS", 100)                             \
+    X(nodeCacheTtlMs, int64_t, "cache.node_ttl_ms", "NODE_CACHE_TTL_MS", 5000)                \
+    X(multiGetMaxIds, int, "multiget.max_ids", "MULTIGET_MAX_IDS", 1000)                      \
+    X(upsertMaxRows, int, "upsert.max_rows", "UPSERT_MAX_ROWS", 1000)                         \
+    X(historyMaxRows, int, "history.max_rows", "HISTORY_MAX_ROWS", 1000)                      \
+    X(writeCoalesceMs, double, "write_coalescing.window_ms", "WRITE_COALESCING_WINDOW_MS", 0) \
+    X(bulkMaxRows, int, "bulk.max_rows", "BULK_MAX_ROWS", 1000)                               \
+    X(jwtSecret, std::string, nullptr, "JWT_SECRET", "")                                      \
+    X(authUsers, StringList, nullptr, "AUTH_USERS", {})
+
+/**
+ * @brief Immutable, typed snapshot of the settings that can change without a restart
+ *
+ * The keys are the RUNTIME_CONFIG_KEYS table above, so each setting is a
+ * plain member with a fixed type: a misspelt key is a compile error and
+ * reading one never touches getenv() or parses anything. build() resolves
+ * every key once, and the snapshot is then published as a whole; a reload
+ * never mutates a snapshot that handlers may be reading. Readers go through
+ * current(), which costs one atomic load while nothing changes: each thread
+ * keeps a reference to the snapshot it last saw and only takes the publish
+ * lock after a reload, so the old snapshot is freed once every IO thread
+ * has moved on (RCU-style grace period by reference count).
+ *
+ * The reference returned by current() stays valid until the same thread
+ * calls current() again; async continuations should capture snapshot().
+ */
+struct RuntimeConfig
+{
+    using StringList = std::vector<std::string>;
+
+#define RUNTIME_CONFIG_MEMBER(name, type, path, env, defaultValue) type name = defaultValue;
+    RUNTIME_CONFIG_KEYS(RUNTIME_CONFIG_MEMBER)
+#undef RUNTIME_CONFIG_MEMBER
+
+    /// Set by publish(); 0 for the built-in defaults
+    uint64_t version{0};
+
+    bool originRejected(std::string_view origin) const;
+    bool originAllowed(std::string_view origin) const;
+
+    /**
+     * Resolve every key from @p dotenv, the process environment and
+     * @p customConfig. Values of the wrong type or out of range keep their
+     * default and are described in @p errors; callers decide whether that is
+     * fatal (startup) or means keeping the previous snapshot (reload).
+     */
+    static std::shared_ptr<RuntimeConfig> build(const Json::Value &customConfig,
+                                                const std::map<std::string, std::string> &dotenv,
+                                                std::vector<std::string> &errors);
+
+    /// KEY=VALUE lines of a .env file; empty if it can't be read
+    static std::map<std::string, std::string> loadEnvFile(const std::string &path);
+
+    /// Latest snapshot, cached per thread; see the class comment for lifetime
+    static const RuntimeConfig &current();
+
+    /// Latest snapshot as an owning pointer, for use across async callbacks
+    static std::shared_ptr<const RuntimeConfig> snapshot();
+
+    /// Swap in @p config for all readers and return its version
+    static uint64_t publish(std::shared_ptr<RuntimeConfig> config);
+};
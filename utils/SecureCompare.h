@@ -0,0 +1,21 @@
+#pragma once
+
+#include <cstddef>
+#include <string_view>
+
+/**
+ * @brief Compare two secrets in time that depends only on their length
+ *
+ * Use for tokens, signatures and hashes so the position of the first
+ * mismatching byte cannot be recovered from response timing.
+ */
+inline bool constantTimeEquals(std::string_view a, std::string_view b)
+{
+    if (a.size() != b.size())
+        return false;
+
+    unsigned char diff = 0;
+    for (size_t i = 0; i < a.size(); ++i)
+        diff |= static_cast<unsigned char>(a[i]) ^ static_cast<unsigned char>(b[i]);
+    return diff == 0;
+}
@@ -0,0 +1,172 @@
+#include "SignedToken.h"
+#include "SecureCompare.h"
+#include <openssl/evp.h>
+#include <openssl/hmac.h>
+#include <memory>
+
+namespace
+{
+const char kAlphabet[] =
+    "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_";
+
+// {"alg":"HS256","typ":"JWT"}
+const std::string kHeader = "eyJhbGciOiJIUzI1NiIsInR5cCI6IkpXVCJ9";
+
+std::string hmacSha256(std::string_view secret, std::string_view data)
+{
+    unsigned char mac[EVP_MAX_MD_SIZE];
+    unsigned int macLen = 0;
+    HMAC(EVP_sha256(),
+         secret.data(),
+         static_cast<int>(secret.size()),
+         reinterpret_cast<const unsigned char *>(data.data()),
+         data.size(),
+         mac,
+         &macLen);
+    return std::string(reinterpret_cast<const char *>(mac), macLen);
+}
+
+std::string toCompactJson(const Json::Value &value)
+{
+    Json::StreamWriterBuilder builder;
+    builder["indentation"] = "";
+    return Json::writeString(builder, value);
+}
+
+bool parseJson(const std::string &text, Json::Value &value)
+{
+    Json::CharReaderBuilder builder;
+    std::unique_ptr<Json::CharReader> reader(builder.newCharReader());
+    std::string errs;
+    return reader->parse(text.data(), text.data() + text.size(), &value, &errs);
+}
+}  // namespace
+
+std::string SignedToken::base64UrlEncode(std::string_view data)
+{
+    std::string out;
+    out.reserve((data.size() + 2) / 3 * 4);
+    size_t i = 0;
+    for (; i + 2 < data.size(); i += 3)
+    {
+        uint32_t n = (static_cast<unsigned char>(data[i]) << 16) |
+                     (static_cast<unsigned char>(data[i + 1]) << 8) |
+                     static_cast<unsigned char>(data[i + 2]);
+        out.push_back(kAlphabet[(n >> 18) & 63]);
+        out.push_back(kAlphabet[(n >> 12) & 63]);
+        out.push_back(kAlphabet[(n >> 6) & 63]);
+        out.push_back(kAlphabet[n & 63]);
+    }
+    if (i + 1 == data.size())
+    {
+        uint32_t n = static_cast<unsigned char>(data[i]) << 16;
+        out.push_back(kAlphabet[(n >> 18) & 63]);
+        out.push_back(kAlphabet[(n >> 12) & 63]);
+    }
+    else if (i + 2 == data.size())
+    {
+        uint32_t n = (static_cast<unsigned char>(data[i]) << 16) |
+                     (static_cast<unsigned char>(data[i + 1]) << 8);
+        out.push_back(kAlphabet[(n >> 18) & 63]);
+        out.push_back(kAlphabet[(n >> 12) & 63]);
+        out.push_back(kAlphabet[(n >> 6) & 63]);
+    }
+    return out;
+}
+
+bool SignedToken::base64UrlDecode(std::string_view in, std::string &out)
+{
+    if (in.size() % 4 == 1)
+        return false;
+
+    out.clear();
+    out.reserve(in.size() * 3 / 4);
+    uint32_t buffer = 0;
+    int bits = 0;
+    for (char c : in)
+    {
+        uint32_t v;
+        if (c >= 'A' && c <= 'Z')
+            v = c - 'A';
+        else if (c >= 'a' && c <= 'z')
+            v = c - 'a' + 26;
+        else if (c >= '0' && c <= '9')
+            v = c - '0' + 52;
+        else if (c == '-')
+            v = 62;
+        else if (c == '_')
+            v = 63;
+        else
+            return false;
+
+        buffer = (buffer << 6) | v;
+        bits += 6;
+        if (bits >= 8)
+        {
+            bits -= 8;
+            out.push_back(static_cast<char>((buffer >> bits) & 0xff));
+        }
+    }
+    return true;
+}
+
+std::string SignedToken::sign(const Json::Value &claims, std::string_view secret)
+{
+    auto signingInput = kHeader + "." + base64UrlEncode(toCompactJson(claims));
+    return signingInput + "." + base64UrlEncode(hmacSha256(secret, signingInput));
+}
+
+bool SignedToken::verify(std::string_view token,
+                         std::string_view secret,
+                         int64_t now,
+                         Json::Value &claims,
+                         std::string &err)
+{
+    auto firstDot = token.find('.');
+    auto lastDot = token.rfind('.');
+    if (firstDot == std::string_view::npos || firstDot == lastDot)
+    {
+        err = "Malformed token";
+        return false;
+    }
+
+    // The header is fixed, so comparing it also pins the algorithm and
+    // rules out "alg":"none" style downgrades.
+    if (token.substr(0, firstDot) != kHeader)
+    {
+        err = "Unsupported token header";
+        return false;
+    }
+
+    auto signingInput = token.substr(0, lastDot);
+    std::string signature;
+    if (!base64UrlDecode(token.substr(lastDot + 1), signature) ||
+        !constantTimeEquals(signature, hmacSha256(secret, signingInput)))
+    {
+        err = "Invalid signature";
+        return false;
+    }
+
+    std::string payload;
+    if (!base64UrlDecode(token.substr(firstDot + 1, lastDot - firstDot - 1),
+                         payload) ||
+        !parseJson(payload, claims) || !claims.isObject())
+    {
+        err = "Malformed claims";
+        return false;
+    }
+
+    if (claims.isMember("exp") &&
+        (!claims["exp"].isIntegral() || claims["exp"].asInt64() <= now))
+    {
+        err = "Token expired";
+        return false;
+    }
+    if (claims.isMember("nbf") &&
+        (!claims["nbf"].isIntegral() || claims["nbf"].asInt64() > now))
+    {
+        err = "Token not yet valid";
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <json/json.h>
+#include <string>
+#include <string_view>
+
+/**
+ * @brief Compact HMAC-SHA256 signed tokens (JWT, HS256)
+ *
+ * header.payload.signature, each part base64url without padding. Only
+ * HS256 is accepted on verification; "exp" and "nbf" (seconds since the
+ * epoch) are enforced when present.
+ */
+namespace SignedToken
+{
+/// Serialize and sign @p claims
+std::string sign(const Json::Value &claims, std::string_view secret);
+
+/// Check signature and time claims; on success fill @p claims.
+/// @param now seconds since the epoch
+bool verify(std::string_view token,
+            std::string_view secret,
+            int64_t now,
+            Json::Value &claims,
+            std::string &err);
+
+std::string base64UrlEncode(std::string_view data);
+bool base64UrlDecode(std::string_view in, std::string &out);
+}  // namespace SignedToken
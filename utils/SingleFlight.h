@@ -0,0 +1,98 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief Collapses concurrent calls for the same key into one
+ *
+ * The first caller for a key becomes the leader and runs the work; callers
+ * arriving while it is in flight only queue their callback. When the
+ * leader's work finishes, every queued callback receives the same result
+ * (on the thread that finished the work) and the key is forgotten, so the
+ * next call starts fresh: this deduplicates in-flight work, it is not a
+ * cache. Keys are spread over mutex-guarded shards so unrelated keys
+ * arriving on different IO threads rarely contend.
+ *
+ * Each flight is stamped with the caller's @c generation. A caller never
+ * joins a flight of an older generation and starts its own instead, so a
+ * read issued after a write (which bumped the generation) cannot be handed
+ * the result of a query that began before it.
+ *
+ * @code
+ * flights.run(key, std::move(callback), [](auto finish) {
+ *     db->execSqlAsync(..., [finish](const Result &r) { finish(toValue(r)); }, ...);
+ * });
+ * @endcode
+ */
+template <typename Result>
+class SingleFlight
+{
+  public:
+    using Callback = std::function<void(const Result &)>;
+    using Finish = std::function<void(Result)>;
+
+    /**
+     * Queue @p callback for @p key and, if no call for @p key of at least
+     * @p generation is in flight, run @p work. @p work must call its Finish
+     * argument exactly once.
+     * @return true if this call ran @p work, false if it joined one
+     */
+    bool run(const std::string &key,
+             Callback callback,
+             const std::function<void(Finish)> &work,
+             uint64_t generation = 0)
+    {
+        auto &shard = shards_[std::hash<std::string>{}(key) % kShards];
+        auto flight = std::make_shared<Flight>();
+        {
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            auto &current = shard.calls[key];
+            if (current && current->generation >= generation)
+            {
+                current->waiters.push_back(std::move(callback));
+                return false;
+            }
+            // An older flight keeps its own waiters and finishes on its own
+            flight->generation = generation;
+            flight->waiters.push_back(std::move(callback));
+            current = flight;
+        }
+        work([&shard, key, flight](Result result) {
+            std::vector<Callback> waiters;
+            {
+                std::lock_guard<std::mutex> lock(shard.mutex);
+                auto it = shard.calls.find(key);
+                if (it != shard.calls.end() && it->second == flight)
+                    shard.calls.erase(it);
+                waiters.swap(flight->waiters);
+            }
+            for (auto &waiter : waiters)
+                waiter(result);
+        });
+        return true;
+    }
+
+  private:
+    static constexpr size_t kShards = 16;
+
+    struct Flight
+    {
+        uint64_t generation{0};
+        std::vector<Callback> waiters;
+    };
+
+    struct Shard
+    {
+        std::mutex mutex;
+        std::unordered_map<std::string, std::shared_ptr<Flight>> calls;
+    };
+
+    std::array<Shard, kShards> shards_;
+};
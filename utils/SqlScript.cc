@@ -0,0 +1,41 @@
+#include "SqlScript.h"
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+namespace SqlScript
+{
+std::vector<std::string> split(const std::string &script)
+{
+    std::vector<std::string> statements;
+    std::istringstream in(script);
+    std::string line, current;
+    while (std::getline(in, line))
+    {
+        auto start = line.find_first_not_of(" \t\r");
+        if (start == std::string::npos || line.compare(start, 2, "--") == 0)
+            continue;
+        current += line;
+        current += '\n';
+        if (line.find_last_not_of(" \t\r") != std::string::npos &&
+            line[line.find_last_not_of(" \t\r")] == ';')
+        {
+            statements.push_back(std::move(current));
+            current.clear();
+        }
+    }
+    if (current.find_first_not_of(" \t\r\n") != std::string::npos)
+        statements.push_back(std::move(current));
+    return statements;
+}
+
+std::vector<std::string> load(const std::string &path)
+{
+    std::ifstream in(path);
+    if (!in)
+        throw std::runtime_error("cannot read " + path);
+    std::stringstream script;
+    script << in.rdbuf();
+    return split(script.str());
+}
+}  // namespace SqlScript
@@ -0,0 +1,21 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+/**
+ * @brief The statements of a .sql file such as sql/schema.sqlite.sql
+ *
+ * Lines starting with "--" are dropped and a statement ends at a line
+ * ending in ';'. That is all the schema files use, so there is no full SQL
+ * tokenizer here: a ';' inside a string literal at the end of a line would
+ * split a statement.
+ */
+namespace SqlScript
+{
+/// Statements of @p script, in order
+std::vector<std::string> split(const std::string &script);
+
+/// Statements of the file at @p path; throws std::runtime_error if it can't be read
+std::vector<std::string> load(const std::string &path);
+}  // namespace SqlScript
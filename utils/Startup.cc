@@ -0,0 +1,216 @@
+#include "Startup.h"
+#include <trantor/utils/Logger.h>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace
+{
+using Clock = std::chrono::steady_clock;
+
+struct Task
+{
+    std::string name;
+    std::function<void(Startup::Done)> run;
+    double ms{-1};  // < 0 while pending
+};
+
+std::mutex mutex;
+Clock::time_point processStart = Clock::now();
+Clock::time_point phaseStart = processStart;
+Clock::time_point warmupStart;
+std::vector<std::pair<std::string, double>> phases;
+std::vector<Task> tasks;
+size_t pending = 0;
+std::atomic<bool> isReady{false};
+std::atomic<bool> isDraining{false};
+std::string root = ".";
+std::string config;
+
+double msSince(Clock::time_point start)
+{
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+fs::path executableDir(const char *argv0)
+{
+    std::error_code ec;
+    auto self = fs::read_symlink("/proc/self/exe", ec);
+    if (!ec)
+        return self.parent_path();
+    if (argv0)
+        return fs::absolute(argv0, ec).parent_path();
+    return fs::current_path(ec);
+}
+
+void finish(size_t index, bool ok)
+{
+    if (!ok)
+        return;  // the task retries on its own and calls done again
+
+    std::ostringstream summary;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (tasks[index].ms >= 0)
+            return;
+        tasks[index].ms = msSince(warmupStart);
+        if (--pending > 0)
+            return;
+
+        phases.emplace_back("warmup", msSince(warmupStart));
+        summary << "Startup finished in " << msSince(processStart) << " ms:";
+        for (const auto &[name, ms] : phases)
+            summary << ' ' << name << ' ' << ms << " ms,";
+        summary << " warm-up tasks [";
+        for (size_t i = 0; i < tasks.size(); ++i)
+            summary << (i ? ", " : "") << tasks[i].name << ' ' << tasks[i].ms << " ms";
+        summary << ']';
+    }
+    isReady = true;
+    LOG_INFO << summary.str();
+}
+}  // namespace
+
+void Startup::begin()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    processStart = phaseStart = Clock::now();
+    phases.clear();
+}
+
+void Startup::phase(const std::string &name)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    auto now = Clock::now();
+    phases.emplace_back(name, std::chrono::duration<double, std::milli>(now - phaseStart).count());
+    phaseStart = now;
+}
+
+std::string Startup::resolveConfigPath(int argc, char **argv)
+{
+    std::vector<fs::path> candidates;
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+        if (arg == "--config" && i + 1 < argc)
+            candidates.emplace_back(argv[i + 1]);
+        else if (arg.rfind("--config=", 0) == 0)
+            candidates.emplace_back(arg.substr(9));
+    }
+    // An explicit path must exist; don't silently fall back to another file
+    bool explicitPath = !candidates.empty();
+    if (!explicitPath)
+    {
+        if (const char *env = std::getenv("APP_CONFIG"))
+        {
+            candidates.emplace_back(env);
+            explicitPath = true;
+        }
+    }
+    if (!explicitPath)
+    {
+        auto exeDir = executableDir(argc > 0 ? argv[0] : nullptr);
+        candidates = {"config.json",
+                      "../config.json",
+                      exeDir / "config.json",
+                      exeDir / ".." / "config.json"};
+    }
+
+    std::string tried;
+    for (const auto &candidate : candidates)
+    {
+        std::error_code ec;
+        if (fs::is_regular_file(candidate, ec))
+        {
+            auto path = fs::canonical(candidate, ec);
+            if (ec)
+                path = fs::absolute(candidate);
+            root = path.parent_path().string();
+            config = path.string();
+            return config;
+        }
+        tried += (tried.empty() ? "" : ", ") + candidate.string();
+    }
+    throw std::runtime_error("config.json not found (tried " + tried + ")");
+}
+
+const std::string &Startup::configPath()
+{
+    return config;
+}
+
+const std::string &Startup::appRoot()
+{
+    return root;
+}
+
+std::string Startup::resolvePath(const std::string &path)
+{
+    fs::path p(path);
+    if (p.is_absolute())
+        return path;
+    return (fs::path(root) / p).lexically_normal().string();
+}
+
+void Startup::addWarmup(std::string name, std::function<void(Done)> task)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    tasks.push_back({std::move(name), std::move(task)});
+}
+
+void Startup::runWarmups()
+{
+    size_t count;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        warmupStart = Clock::now();
+        pending = tasks.size();
+        count = tasks.size();
+    }
+    if (count == 0)
+    {
+        isReady = true;
+        LOG_INFO << "Startup finished in " << msSince(processStart) << " ms (no warm-up tasks)";
+        return;
+    }
+    // tasks is not modified after this point, so run can be read unlocked
+    for (size_t i = 0; i < count; ++i)
+        tasks[i].run([i](bool ok) { finish(i, ok); });
+}
+
+bool Startup::ready()
+{
+    return isReady.load(std::memory_order_acquire) &&
+           !isDraining.load(std::memory_order_acquire);
+}
+
+void Startup::setDraining()
+{
+    isDraining = true;
+}
+
+Json::Value Startup::status()
+{
+    Json::Value json;
+    json["ready"] = ready();
+    json["draining"] = isDraining.load(std::memory_order_acquire);
+    json["pending"] = Json::Value(Json::arrayValue);
+    std::lock_guard<std::mutex> lock(mutex);
+    for (const auto &[name, ms] : phases)
+        json["phases_ms"][name] = ms;
+    for (const auto &task : tasks)
+    {
+        if (task.ms < 0)
+            json["pending"].append(task.name);
+        else
+            json["warmup_ms"][task.name] = task.ms;
+    }
+    return json;
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <json/json.h>
+#include <functional>
+#include <string>
+
+/**
+ * @brief Startup bookkeeping: config discovery, phase timings, warm-up gate
+ *
+ * main() marks phases as it goes (config parse, framework start, ...) and
+ * registers warm-up tasks (DB pools, file caches). runWarmups() starts them
+ * all at once; each task reports completion through its Done callback and
+ * may finish on any thread. Once every task has succeeded the process is
+ * ready and a one-line timing breakdown is logged.
+ */
+namespace Startup
+{
+using Done = std::function<void(bool ok)>;
+
+/// Start the clock; call first thing in main()
+void begin();
+
+/// Close the current phase under @p name and start the next one
+void phase(const std::string &name);
+
+/**
+ * Find config.json: --config <path> / --config=<path>, then $APP_CONFIG,
+ * then config.json in the working directory, its parent, the executable's
+ * directory and its parent. Throws std::runtime_error listing the paths
+ * tried. The directory of the chosen file becomes appRoot().
+ */
+std::string resolveConfigPath(int argc, char **argv);
+
+/// Path returned by the last resolveConfigPath() ("" before that)
+const std::string &configPath();
+
+/// Directory holding config.json (working directory if not resolved)
+const std::string &appRoot();
+
+/// @p path unchanged if absolute, otherwise relative to appRoot()
+std::string resolvePath(const std::string &path);
+
+/// Register a warm-up task; must be called before runWarmups()
+void addWarmup(std::string name, std::function<void(Done)> task);
+
+/// Run every registered task in parallel
+void runWarmups();
+
+/// All warm-up tasks done and not draining
+bool ready();
+
+/// Shutdown has started; ready() is false from now on
+void setDraining();
+
+/// {"ready", "draining", "pending": [...], "phases_ms": {...}, "warmup_ms": {...}}
+Json::Value status();
+}  // namespace Startup
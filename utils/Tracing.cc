@@ -0,0 +1,321 @@
+#include "Tracing.h"
+#include <chrono>
+#include <random>
+
+namespace
+{
+std::atomic<uint64_t> sampleThreshold{0};  // sampled when random < threshold
+std::atomic<uint64_t> droppedCount{0};
+std::unique_ptr<Tracing::SpanRing> ring;
+
+std::mt19937_64 &rng()
+{
+    thread_local std::mt19937_64 engine{std::random_device{}()};
+    return engine;
+}
+
+uint64_t randomId()
+{
+    uint64_t id;
+    do
+    {
+        id = rng()();
+    } while (id == 0);
+    return id;
+}
+
+void appendHex(std::string &out, uint64_t value)
+{
+    static const char digits[] = "0123456789abcdef";
+    for (int shift = 60; shift >= 0; shift -= 4)
+        out += digits[(value >> shift) & 0xf];
+}
+
+bool parseHex(std::string_view text, uint64_t &value)
+{
+    value = 0;
+    for (char c : text)
+    {
+        value <<= 4;
+        if (c >= '0' && c <= '9')
+            value |= static_cast<uint64_t>(c - '0');
+        else if (c >= 'a' && c <= 'f')
+            value |= static_cast<uint64_t>(c - 'a' + 10);
+        else
+            return false;
+    }
+    return true;
+}
+
+std::string nanos(int64_t us)
+{
+    return std::to_string(us) + "000";
+}
+}  // namespace
+
+int64_t Tracing::nowUs()
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+               std::chrono::system_clock::now().time_since_epoch())
+        .count();
+}
+
+bool Tracing::parseTraceparent(std::string_view header,
+                               uint64_t &traceHi,
+                               uint64_t &traceLo,
+                               uint64_t &spanId,
+                               bool &sampled)
+{
+    // version-traceid-parentid-flags
+    if (header.size() < 55 || header[2] != '-' || header[35] != '-' || header[52] != '-')
+        return false;
+    uint64_t version, flags;
+    if (!parseHex(header.substr(0, 2), version) || version == 0xff ||
+        (version == 0 && header.size() != 55) ||
+        !parseHex(header.substr(3, 16), traceHi) ||
+        !parseHex(header.substr(19, 16), traceLo) ||
+        !parseHex(header.substr(36, 16), spanId) ||
+        !parseHex(header.substr(53, 2), flags))
+        return false;
+    if ((traceHi == 0 && traceLo == 0) || spanId == 0)
+        return false;
+    sampled = flags & 0x01;
+    return true;
+}
+
+Tracing::Span Tracing::Span::root(std::string_view traceparent,
+                                  const char *name,
+                                  int64_t startUs)
+{
+    Span span;
+    bool sampled = false;
+    if (!traceparent.empty() &&
+        parseTraceparent(traceparent, span.traceHi_, span.traceLo_, span.parentId_, sampled))
+    {
+        // Parent-based: honour the caller's decision. Unsampled, the
+        // caller's span id is passed on as is rather than generating one
+        span.sampled_ = sampled;
+        span.valid_ = true;
+        if (!sampled)
+        {
+            span.spanId_ = span.parentId_;
+            return span;
+        }
+    }
+    else
+    {
+        auto threshold = sampleThreshold.load(std::memory_order_relaxed);
+        if (threshold == 0)
+            return span;
+        span.sampled_ = threshold == UINT64_MAX || rng()() < threshold;
+        if (!span.sampled_)
+            return span;
+        span.traceHi_ = randomId();
+        span.traceLo_ = randomId();
+        span.parentId_ = 0;
+    }
+    span.valid_ = true;
+    span.spanId_ = randomId();
+    span.name_ = name;
+    span.kind_ = SpanKind::Server;
+    span.startUs_ = startUs ? startUs : nowUs();
+    return span;
+}
+
+Tracing::Span Tracing::Span::child(const char *name, int64_t startUs) const
+{
+    if (!sampled_)
+        return Span();
+    Span span;
+    span.traceHi_ = traceHi_;
+    span.traceLo_ = traceLo_;
+    span.parentId_ = spanId_;
+    span.spanId_ = randomId();
+    span.name_ = name;
+    span.startUs_ = startUs ? startUs : nowUs();
+    span.sampled_ = true;
+    span.valid_ = true;
+    return span;
+}
+
+void Tracing::Span::end(const char *attribute, int64_t value, bool error, int64_t endUs) const
+{
+    if (!sampled_ || !ring)
+        return;
+    SpanRecord record;
+    record.traceHi = traceHi_;
+    record.traceLo = traceLo_;
+    record.spanId = spanId_;
+    record.parentId = parentId_;
+    record.name = name_;
+    record.kind = kind_;
+    record.startUs = startUs_;
+    record.endUs = endUs ? endUs : nowUs();
+    record.attribute = attribute;
+    record.value = value;
+    record.error = error;
+    if (!ring->push(record))
+        droppedCount.fetch_add(1, std::memory_order_relaxed);
+}
+
+std::string Tracing::Span::traceparent() const
+{
+    if (!valid_)
+        return {};
+    std::string out = "00-";
+    out.reserve(55);
+    appendHex(out, traceHi_);
+    appendHex(out, traceLo_);
+    out += '-';
+    appendHex(out, spanId_);
+    out += sampled_ ? "-01" : "-00";
+    return out;
+}
+
+Tracing::SpanRing::SpanRing(size_t capacity)
+{
+    size_t size = 2;
+    while (size < capacity)
+        size <<= 1;
+    mask_ = size - 1;
+    cells_.reset(new Cell[size]);
+    for (size_t i = 0; i < size; ++i)
+        cells_[i].sequence.store(i, std::memory_order_relaxed);
+}
+
+bool Tracing::SpanRing::push(const SpanRecord &record)
+{
+    auto pos = enqueuePos_.load(std::memory_order_relaxed);
+    for (;;)
+    {
+        auto &cell = cells_[pos & mask_];
+        auto seq = cell.sequence.load(std::memory_order_acquire);
+        auto diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+        if (diff == 0)
+        {
+            if (enqueuePos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+            {
+                cell.record = record;
+                cell.sequence.store(pos + 1, std::memory_order_release);
+                return true;
+            }
+        }
+        else if (diff < 0)
+        {
+            return false;
+        }
+        else
+        {
+            pos = enqueuePos_.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+bool Tracing::SpanRing::pop(SpanRecord &record)
+{
+    auto pos = dequeuePos_.load(std::memory_order_relaxed);
+    for (;;)
+    {
+        auto &cell = cells_[pos & mask_];
+        auto seq = cell.sequence.load(std::memory_order_acquire);
+        auto diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos + 1);
+        if (diff == 0)
+        {
+            if (dequeuePos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+            {
+                record = cell.record;
+                cell.sequence.store(pos + mask_ + 1, std::memory_order_release);
+                return true;
+            }
+        }
+        else if (diff < 0)
+        {
+            return false;
+        }
+        else
+        {
+            pos = dequeuePos_.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+void Tracing::configure(double sampleRatio, size_t ringCapacity)
+{
+    ring = std::make_unique<SpanRing>(ringCapacity);
+    if (sampleRatio <= 0)
+        sampleThreshold = 0;
+    else if (sampleRatio >= 1)
+        sampleThreshold = UINT64_MAX;
+    else
+        sampleThreshold = static_cast<uint64_t>(sampleRatio * 18446744073709551615.0);
+}
+
+size_t Tracing::drain(std::vector<SpanRecord> &out)
+{
+    if (!ring)
+        return 0;
+    size_t count = 0;
+    SpanRecord record;
+    while (ring->pop(record))
+    {
+        out.push_back(record);
+        ++count;
+    }
+    return count;
+}
+
+uint64_t Tracing::dropped()
+{
+    return droppedCount.load(std::memory_order_relaxed);
+}
+
+Json::Value Tracing::toOtlpJson(const std::vector<SpanRecord> &spans,
+                                const std::string &serviceName)
+{
+    Json::Value serviceAttr;
+    serviceAttr["key"] = "service.name";
+    serviceAttr["value"]["stringValue"] = serviceName;
+
+    Json::Value scopeSpans;
+    scopeSpans["scope"]["name"] = "culture_hub";
+    scopeSpans["spans"] = Json::Value(Json::arrayValue);
+    for (const auto &record : spans)
+    {
+        Json::Value span;
+        std::string traceId, spanId;
+        appendHex(traceId, record.traceHi);
+        appendHex(traceId, record.traceLo);
+        appendHex(spanId, record.spanId);
+        span["traceId"] = traceId;
+        span["spanId"] = spanId;
+        if (record.parentId)
+        {
+            std::string parentId;
+            appendHex(parentId, record.parentId);
+            span["parentSpanId"] = parentId;
+        }
+        span["name"] = record.name;
+        span["kind"] = static_cast<int>(record.kind);
+        span["startTimeUnixNano"] = nanos(record.startUs);
+        span["endTimeUnixNano"] = nanos(record.endUs);
+        if (record.attribute)
+        {
+            Json::Value attr;
+            attr["key"] = record.attribute;
+            attr["value"]["intValue"] = std::to_string(record.value);
+            span["attributes"].append(attr);
+        }
+        // STATUS_CODE_ERROR
+        if (record.error)
+            span["status"]["code"] = 2;
+        scopeSpans["spans"].append(span);
+    }
+
+    Json::Value resourceSpans;
+    resourceSpans["resource"]["attributes"].append(serviceAttr);
+    resourceSpans["scopeSpans"].append(scopeSpans);
+
+    Json::Value body;
+    body["resourceSpans"].append(resourceSpans);
+    return body;
+}
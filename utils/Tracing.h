@@ -0,0 +1,135 @@
+#pragma once
+
+#include <json/json.h>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @brief Minimal request tracing (W3C trace context, OTLP/JSON export)
+ *
+ * A Span is a small copyable handle that can be captured into async
+ * callbacks; end() records it into a process-wide bounded ring that an
+ * exporter drains in the background. The sampling decision is made once
+ * per trace at the root (or inherited from an incoming traceparent), and
+ * an unsampled span costs a branch: no ids are generated, nothing is
+ * recorded.
+ *
+ * Span names and attribute keys must be string literals (only the pointer
+ * is stored).
+ */
+namespace Tracing
+{
+/// OTLP SpanKind values
+enum class SpanKind : uint8_t
+{
+    Internal = 1,
+    Server = 2
+};
+
+struct SpanRecord
+{
+    uint64_t traceHi{0};
+    uint64_t traceLo{0};
+    uint64_t spanId{0};
+    uint64_t parentId{0};
+    const char *name{""};
+    SpanKind kind{SpanKind::Internal};
+    int64_t startUs{0};  // unix epoch
+    int64_t endUs{0};
+    const char *attribute{nullptr};  // optional integer attribute
+    int64_t value{0};
+    bool error{false};
+};
+
+class Span
+{
+  public:
+    /// Unsampled no-op span
+    Span() = default;
+
+    /// Start a server span, continuing @p traceparent if it is valid.
+    /// @param startUs unix epoch microseconds, 0 for now
+    static Span root(std::string_view traceparent, const char *name, int64_t startUs = 0);
+
+    Span child(const char *name, int64_t startUs = 0) const;
+
+    /// Record the span with an optional integer attribute (e.g.
+    /// "http.status_code", "db.rows"); call at most once
+    void end(const char *attribute = nullptr,
+             int64_t value = 0,
+             bool error = false,
+             int64_t endUs = 0) const;
+
+    bool sampled() const
+    {
+        return sampled_;
+    }
+
+    /// "00-<trace id>-<span id>-<flags>", empty for an invalid span
+    std::string traceparent() const;
+
+  private:
+    uint64_t traceHi_{0};
+    uint64_t traceLo_{0};
+    uint64_t spanId_{0};
+    uint64_t parentId_{0};
+    const char *name_{""};
+    SpanKind kind_{SpanKind::Internal};
+    int64_t startUs_{0};
+    bool sampled_{false};
+    // Sampled-out roots still carry the incoming trace id for propagation
+    bool valid_{false};
+};
+
+/// Bounded lock-free MPMC queue (Vyukov); push fails when full
+class SpanRing
+{
+  public:
+    explicit SpanRing(size_t capacity);
+
+    bool push(const SpanRecord &record);
+    bool pop(SpanRecord &record);
+
+    size_t capacity() const
+    {
+        return mask_ + 1;
+    }
+
+  private:
+    struct Cell
+    {
+        std::atomic<size_t> sequence;
+        SpanRecord record;
+    };
+
+    size_t mask_;
+    std::unique_ptr<Cell[]> cells_;
+    alignas(64) std::atomic<size_t> enqueuePos_{0};
+    alignas(64) std::atomic<size_t> dequeuePos_{0};
+};
+
+/// Sampling ratio for new traces (0..1) and ring capacity; call before use
+void configure(double sampleRatio, size_t ringCapacity);
+
+/// Move every recorded span into @p out; returns the count
+size_t drain(std::vector<SpanRecord> &out);
+
+/// Spans dropped because the ring was full
+uint64_t dropped();
+
+/// Parse "00-<32 hex>-<16 hex>-<2 hex>"
+bool parseTraceparent(std::string_view header,
+                      uint64_t &traceHi,
+                      uint64_t &traceLo,
+                      uint64_t &spanId,
+                      bool &sampled);
+
+/// OTLP/JSON ExportTraceServiceRequest body
+Json::Value toOtlpJson(const std::vector<SpanRecord> &spans, const std::string &serviceName);
+
+int64_t nowUs();
+}  // namespace Tracing
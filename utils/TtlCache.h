@@ -0,0 +1,119 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+/**
+ * @brief Sharded in-memory cache of immutable values with a per-entry TTL
+ *
+ * Values are shared_ptr<const Value>, so a hit hands out the cached object
+ * without copying it. Times are passed in by the caller (microseconds),
+ * which keeps the cache independent of any clock.
+ *
+ * invalidate() leaves a tombstone, and put() takes the time the value's
+ * fetch started: a read that began before a write and returns after it
+ * cannot re-insert the old value. Expired entries are dropped lazily on
+ * access and when a shard grows past its share of @c maxEntries.
+ */
+template <typename Key, typename Value>
+class TtlCache
+{
+  public:
+    using ValuePtr = std::shared_ptr<const Value>;
+
+    explicit TtlCache(size_t maxEntries) : shardCapacity_(maxEntries / kShards + 1)
+    {
+    }
+
+    /// Live value for @p key, or null
+    ValuePtr get(const Key &key, int64_t nowUs)
+    {
+        auto &shard = shardFor(key);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        auto it = shard.entries.find(key);
+        if (it == shard.entries.end() || !it->second.value)
+            return nullptr;
+        if (it->second.expiresUs <= nowUs)
+        {
+            shard.entries.erase(it);
+            return nullptr;
+        }
+        return it->second.value;
+    }
+
+    /**
+     * Cache @p value for @p ttlUs unless @p key was invalidated at or after
+     * @p fetchStartUs. A ttl of 0 disables caching.
+     */
+    void put(const Key &key, ValuePtr value, int64_t fetchStartUs, int64_t nowUs, int64_t ttlUs)
+    {
+        if (ttlUs <= 0)
+            return;
+        auto &shard = shardFor(key);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        auto it = shard.entries.find(key);
+        if (it != shard.entries.end())
+        {
+            if (!it->second.value && it->second.invalidatedUs >= fetchStartUs &&
+                it->second.expiresUs > nowUs)
+                return;
+            it->second = {std::move(value), nowUs + ttlUs, 0};
+            return;
+        }
+        if (shard.entries.size() >= shardCapacity_)
+            evict(shard, nowUs);
+        shard.entries.emplace(key, Entry{std::move(value), nowUs + ttlUs, 0});
+    }
+
+    /// Drop @p key and reject values fetched before now
+    void invalidate(const Key &key, int64_t nowUs)
+    {
+        auto &shard = shardFor(key);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        shard.entries[key] = Entry{nullptr, nowUs + kTombstoneUs, nowUs};
+    }
+
+  private:
+    static constexpr size_t kShards = 16;
+    // Longer than any query is allowed to run
+    static constexpr int64_t kTombstoneUs = 60 * 1000000LL;
+
+    struct Entry
+    {
+        ValuePtr value;  // null for a tombstone
+        int64_t expiresUs;
+        int64_t invalidatedUs;
+    };
+
+    struct Shard
+    {
+        std::mutex mutex;
+        std::unordered_map<Key, Entry> entries;
+    };
+
+    Shard &shardFor(const Key &key)
+    {
+        return shards_[std::hash<Key>{}(key) % kShards];
+    }
+
+    void evict(Shard &shard, int64_t nowUs)
+    {
+        for (auto it = shard.entries.begin(); it != shard.entries.end();)
+        {
+            if (it->second.expiresUs <= nowUs)
+                it = shard.entries.erase(it);
+            else
+                ++it;
+        }
+        // Still full of live entries: make room by dropping an arbitrary one
+        if (shard.entries.size() >= shardCapacity_)
+            shard.entries.erase(shard.entries.begin());
+    }
+
+    const size_t shardCapacity_;
+    std::array<Shard, kShards> shards_;
+};
@@ -0,0 +1,137 @@
+#pragma once
+
+#include <trantor/net/EventLoop.h>
+#include <array>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Write-behind merging of rapid successive writes to the same key
+ *
+ * submit() folds @p changes into whatever is pending for @p key with the
+ * Merge function and queues the callback. The first change of a window
+ * arms a timer of @c windowSec on the calling thread's event loop; when it
+ * fires, the merged changes go out in one call to the Write function and
+ * every caller queued in that window receives its result (on the thread
+ * that finished the write). Changes arriving while a write is in flight
+ * start the next window, and that window is written only after the
+ * previous write finished, so writes to one key never overtake each other.
+ * A window of 0 merges whatever the loop handles in its current iteration;
+ * called off an event loop, submit() writes at once.
+ *
+ * Keys are spread over mutex-guarded shards like SingleFlight, since
+ * successive writes to one key may arrive on different IO threads.
+ */
+template <typename Key, typename Changes, typename Result>
+class WriteCoalescer
+{
+  public:
+    using Callback = std::function<void(const Result &)>;
+    using Finish = std::function<void(Result)>;
+    /// Fold @p later into @p pending; later values win
+    using Merge = std::function<void(Changes &pending, const Changes &later)>;
+    /// Apply @p changes to @p key and call Finish exactly once
+    using Write = std::function<void(const Key &key, Changes changes, Finish finish)>;
+
+    WriteCoalescer(Merge merge, Write write) : merge_(std::move(merge)), write_(std::move(write))
+    {
+    }
+
+    /**
+     * Queue @p changes and @p callback for @p key.
+     * @return true if this call opened a new window, false if it joined one
+     */
+    bool submit(const Key &key, const Changes &changes, Callback callback, double windowSec)
+    {
+        auto &shard = shardFor(key);
+        {
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            auto &entry = shard.entries[key];
+            entry.waiting.push_back(std::move(callback));
+            if (entry.changes)
+            {
+                merge_(*entry.changes, changes);
+                return false;
+            }
+            entry.changes = changes;
+            entry.armed = true;
+        }
+
+        auto *loop = trantor::EventLoop::getEventLoopOfCurrentThread();
+        if (!loop)
+            due(key);
+        else if (windowSec > 0)
+            loop->runAfter(windowSec, [this, key]() { due(key); });
+        else
+            loop->queueInLoop([this, key]() { due(key); });
+        return true;
+    }
+
+  private:
+    static constexpr size_t kShards = 16;
+
+    struct Entry
+    {
+        std::optional<Changes> changes;  // pending for the next write
+        std::vector<Callback> waiting;   // callers whose changes are pending
+        bool armed{false};               // the window timer is running
+        bool writing{false};             // a write for this key is in flight
+    };
+
+    struct Shard
+    {
+        std::mutex mutex;
+        std::unordered_map<Key, Entry> entries;
+    };
+
+    Shard &shardFor(const Key &key)
+    {
+        return shards_[std::hash<Key>{}(key) % kShards];
+    }
+
+    // The window of @p key is over: write now, or once the write in flight
+    // has finished
+    void due(const Key &key)
+    {
+        auto &shard = shardFor(key);
+        std::optional<Changes> changes;
+        auto waiting = std::make_shared<std::vector<Callback>>();
+        {
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            auto &entry = shard.entries[key];
+            entry.armed = false;
+            if (entry.writing || !entry.changes)
+                return;
+            changes.swap(entry.changes);
+            waiting->swap(entry.waiting);
+            entry.writing = true;
+        }
+
+        write_(key, std::move(*changes), [this, &shard, key, waiting](Result result) {
+            bool next = false;
+            {
+                std::lock_guard<std::mutex> lock(shard.mutex);
+                auto &entry = shard.entries[key];
+                entry.writing = false;
+                if (!entry.changes)
+                    shard.entries.erase(key);
+                // The next window already ended while this write ran
+                else
+                    next = !entry.armed;
+            }
+            for (auto &callback : *waiting)
+                callback(result);
+            if (next)
+                due(key);
+        });
+    }
+
+    Merge merge_;
+    Write write_;
+    std::array<Shard, kShards> shards_;
+};
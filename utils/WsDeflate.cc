@@ -0,0 +1,175 @@
+#include "WsDeflate.h"
+#include <algorithm>
+
+namespace
+{
+constexpr unsigned char kSyncFlushTail[] = {0x00, 0x00, 0xff, 0xff};
+constexpr size_t kMinInflateChunk = 256;
+}  // namespace
+
+WsDeflateCodec::WsDeflateCodec(const Options &options) : options_(options)
+{
+}
+
+WsDeflateCodec::~WsDeflateCodec()
+{
+    if (deflaterReady_)
+        deflateEnd(&deflater_);
+    if (inflaterReady_)
+        inflateEnd(&inflater_);
+}
+
+bool WsDeflateCodec::initDeflater()
+{
+    if (deflaterReady_)
+        return true;
+    // Negative window bits select a raw stream (no zlib header/trailer)
+    deflaterReady_ = deflateInit2(&deflater_,
+                                  options_.level,
+                                  Z_DEFLATED,
+                                  -options_.windowBits,
+                                  options_.memLevel,
+                                  Z_DEFAULT_STRATEGY) == Z_OK;
+    return deflaterReady_;
+}
+
+bool WsDeflateCodec::initInflater()
+{
+    if (inflaterReady_)
+        return true;
+    inflaterReady_ = inflateInit2(&inflater_, -options_.windowBits) == Z_OK;
+    return inflaterReady_;
+}
+
+bool WsDeflateCodec::compress(std::string_view in, std::string &out)
+{
+    if (deflateBroken_ || !initDeflater())
+        return false;
+
+    auto start = out.size();
+    deflater_.next_in =
+        reinterpret_cast<Bytef *>(const_cast<char *>(in.data()));
+    deflater_.avail_in = static_cast<uInt>(in.size());
+    // The bound (plus the sync flush marker) normally fits in one pass, and
+    // zero-filling a fixed large chunk would dominate small messages.
+    auto chunk = deflateBound(&deflater_, in.size()) + 16;
+    do
+    {
+        auto offset = out.size();
+        out.resize(offset + chunk);
+        deflater_.next_out = reinterpret_cast<Bytef *>(&out[offset]);
+        deflater_.avail_out = static_cast<uInt>(chunk);
+        auto ret = deflate(&deflater_, Z_SYNC_FLUSH);
+        out.resize(out.size() - deflater_.avail_out);
+        if (ret != Z_OK && ret != Z_BUF_ERROR)
+        {
+            out.resize(start);
+            // With context takeover the peer's window already differs from
+            // ours; resetting would only hide that, so the stream stays broken
+            if (options_.contextTakeover)
+                deflateBroken_ = true;
+            else
+                deflateReset(&deflater_);
+            return false;
+        }
+    } while (deflater_.avail_out == 0);
+
+    // Every sync flush ends with an empty stored block; the receiver
+    // re-appends it, so it never goes over the wire.
+    if (out.size() - start >= sizeof(kSyncFlushTail) &&
+        out.compare(out.size() - sizeof(kSyncFlushTail),
+                    sizeof(kSyncFlushTail),
+                    reinterpret_cast<const char *>(kSyncFlushTail),
+                    sizeof(kSyncFlushTail)) == 0)
+    {
+        out.resize(out.size() - sizeof(kSyncFlushTail));
+    }
+
+    if (!options_.contextTakeover)
+        deflateReset(&deflater_);
+    return true;
+}
+
+bool WsDeflateCodec::decompress(std::string_view in, std::string &out)
+{
+    if (!initInflater())
+        return false;
+
+    auto start = out.size();
+    auto chunk = std::max(kMinInflateChunk, in.size() * 4);
+    auto inflateChunk = [this, &out, &chunk, start](const unsigned char *data,
+                                                    size_t len) {
+        inflater_.next_in = const_cast<Bytef *>(data);
+        inflater_.avail_in = static_cast<uInt>(len);
+        do
+        {
+            auto offset = out.size();
+            if (offset - start > options_.maxMessageSize)
+                return false;
+            out.resize(offset + chunk);
+            inflater_.next_out = reinterpret_cast<Bytef *>(&out[offset]);
+            inflater_.avail_out = static_cast<uInt>(chunk);
+            auto ret = inflate(&inflater_, Z_SYNC_FLUSH);
+            out.resize(out.size() - inflater_.avail_out);
+            if (ret != Z_OK && ret != Z_BUF_ERROR && ret != Z_STREAM_END)
+                return false;
+            if (inflater_.avail_out == 0)
+                chunk *= 2;
+        } while (inflater_.avail_out == 0);
+        return out.size() - start <= options_.maxMessageSize;
+    };
+
+    if (!inflateChunk(reinterpret_cast<const unsigned char *>(in.data()),
+                      in.size()) ||
+        !inflateChunk(kSyncFlushTail, sizeof(kSyncFlushTail)))
+    {
+        out.resize(start);
+        inflateReset(&inflater_);
+        return false;
+    }
+
+    if (!options_.contextTakeover)
+        inflateReset(&inflater_);
+    return true;
+}
+
+bool WsDeflateCodec::encode(std::string_view payload,
+                            bool isText,
+                            std::string &out)
+{
+    auto header = out.size();
+    uint8_t flags = isText ? kText : 0;
+    out.push_back(0);
+    if (payload.size() >= options_.minSize && compress(payload, out))
+    {
+        flags |= kCompressed;
+    }
+    else if (deflateBroken_)
+    {
+        out.resize(header);
+        return false;
+    }
+    else
+    {
+        out.append(payload.data(), payload.size());
+    }
+    out[header] = static_cast<char>(flags);
+    return true;
+}
+
+bool WsDeflateCodec::decode(std::string_view frame,
+                            std::string &payload,
+                            bool &isText)
+{
+    if (frame.empty())
+        return false;
+
+    auto flags = static_cast<uint8_t>(frame.front());
+    frame.remove_prefix(1);
+    isText = (flags & kText) != 0;
+    if (flags & kCompressed)
+        return decompress(frame, payload);
+
+    payload.append(frame.data(), frame.size());
+    return true;
+}
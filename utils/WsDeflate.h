@@ -0,0 +1,85 @@
+#pragma once
+
+#include <zlib.h>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+/**
+ * @brief Per-message DEFLATE codec for WebSocket payloads
+ *
+ * Produces the same raw-DEFLATE body as RFC 7692 (permessage-deflate):
+ * each message is flushed with Z_SYNC_FLUSH and the trailing
+ * 0x00 0x00 0xff 0xff is stripped on compression and re-appended on
+ * decompression.
+ *
+ * With context takeover the LZ77 window survives between messages, which
+ * is what makes small repetitive JSON events shrink, at the price of
+ * keeping one codec (window + hash tables) per connection. Without it the
+ * streams are reset after every message and a single codec can be shared
+ * by all connections of a thread.
+ *
+ * Drogon does not let handlers negotiate Sec-WebSocket-Extensions or set
+ * RSV1, so compressed messages travel in binary frames prefixed with a
+ * one-byte envelope (see WsDeflateCodec::Envelope).
+ */
+class WsDeflateCodec
+{
+  public:
+    struct Options
+    {
+        int level{6};
+        int windowBits{15};
+        int memLevel{8};
+        bool contextTakeover{true};
+        size_t minSize{256};                  ///< smaller messages are sent as-is
+        size_t maxMessageSize{16 * 1024 * 1024};  ///< inflate limit
+    };
+
+    /// Envelope flags carried in the first byte of an enveloped frame
+    enum Envelope : uint8_t
+    {
+        kText = 0x01,
+        kCompressed = 0x02,
+    };
+
+    explicit WsDeflateCodec(const Options &options);
+    ~WsDeflateCodec();
+
+    WsDeflateCodec(const WsDeflateCodec &) = delete;
+    WsDeflateCodec &operator=(const WsDeflateCodec &) = delete;
+
+    /// Compress one message; appends to @p out. Returns false on zlib error;
+    /// with context takeover every later call then fails too, since the
+    /// peer's window no longer matches.
+    bool compress(std::string_view in, std::string &out);
+
+    /// Decompress one message; appends to @p out. Returns false on malformed
+    /// input or when the result would exceed maxMessageSize.
+    bool decompress(std::string_view in, std::string &out);
+
+    /// Wrap a payload in an envelope, compressing it if it is large enough.
+    /// Falls back to an uncompressed envelope when compression fails, except
+    /// with context takeover: then it returns false and the connection must
+    /// be closed (1011).
+    bool encode(std::string_view payload, bool isText, std::string &out);
+
+    /// Unwrap an enveloped frame into its payload and original text/binary type
+    bool decode(std::string_view frame, std::string &payload, bool &isText);
+
+    const Options &options() const
+    {
+        return options_;
+    }
+
+  private:
+    bool initDeflater();
+    bool initInflater();
+
+    Options options_;
+    z_stream deflater_{};
+    z_stream inflater_{};
+    bool deflaterReady_{false};
+    bool deflateBroken_{false};  // compression failed with context takeover
+    bool inflaterReady_{false};
+};